@@ -0,0 +1,40 @@
+#pragma once
+#include <chrono>
+#include <iostream>
+#include <streambuf>
+#include "CommandBuffer.h"
+
+// Helpers shared by the benchmarks. Each benchmark is a plain function that prints its
+// timings and returns false if one of its checks failed; BenchMain.cpp lists them.
+
+// Wall time of fn() in milliseconds
+template<typename Fn>
+double measureMilliseconds(Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// The engine logs every object it creates and destroys. This keeps that out of the
+// timings by detaching std::cout until it goes out of scope.
+class QuietOutput {
+public:
+    QuietOutput() : m_buffer(std::cout.rdbuf(nullptr)) {}
+    ~QuietOutput() {
+        std::cout.rdbuf(m_buffer);
+        std::cout.clear();
+    }
+    QuietOutput(const QuietOutput&) = delete;
+    QuietOutput& operator=(const QuietOutput&) = delete;
+
+private:
+    std::streambuf* m_buffer;
+};
+
+// Throws away every object a benchmark made, the same way a scene switch does
+inline void releaseBenchScene() {
+    QuietOutput quiet;
+    CommandBuffer::getInstance().clearScene();
+    CommandBuffer::getInstance().flush();
+}
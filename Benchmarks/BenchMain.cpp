@@ -0,0 +1,52 @@
+#include "Bench.h"
+#include <cstring>
+
+bool benchComponentLookup();
+bool benchSceneTeardown();
+bool testFrameAllocations();
+bool benchObjectPool();
+bool benchGameObjectChurn();
+bool benchJobSystemScaling();
+bool benchImpulseDamage();
+
+namespace {
+    struct Benchmark {
+        const char* name;
+        bool (*run)();
+    };
+
+    const Benchmark benchmarks[] = {
+        { "component-lookup", benchComponentLookup },
+        { "scene-teardown", benchSceneTeardown },
+        { "frame-allocations", testFrameAllocations },
+        { "object-pool", benchObjectPool },
+        { "gameobject-churn", benchGameObjectChurn },
+        { "job-scaling", benchJobSystemScaling },
+        { "impulse-damage", benchImpulseDamage },
+    };
+}
+
+// Usage: Benchmarks [name ...]
+// Runs the named benchmarks, or all of them, and exits non-zero if any check failed.
+// Build in Release; run from the PhysicsProject directory so the sprites can be found.
+int main(int argc, char* argv[]) {
+    int failures = 0;
+    for (const Benchmark& benchmark : benchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], benchmark.name) == 0) {
+                selected = true;
+            }
+        }
+        if (!selected) {
+            continue;
+        }
+
+        std::cout << "== " << benchmark.name << std::endl;
+        if (!benchmark.run()) {
+            std::cout << "FAILED: " << benchmark.name << std::endl;
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
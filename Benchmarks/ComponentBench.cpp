@@ -0,0 +1,147 @@
+#include "Bench.h"
+#include "GameObject.h"
+#include "ComponentManager.h"
+#include "EventSystem.h"
+#include <unordered_map>
+#include <memory>
+#include <vector>
+
+namespace {
+    // Stand-ins with no hooks, so they stay out of the update, event and collision lists
+    struct LookupA : Component { float value = 0.0f; };
+    struct LookupB : Component { float value = 0.0f; };
+    struct LookupC : Component { float value = 0.0f; };
+    struct LookupD : Component { float value = 0.0f; };
+
+    // Overrides handleEvent, so ComponentManager subscribes it to the EventSystem
+    struct TeardownListener : Component {
+        static constexpr EventCategory::Mask EventInterest = EventCategory::Key;
+        static inline std::size_t eventsHandled = 0;
+        void handleEvent(const sf::Event&) override { ++eventsHandled; }
+    };
+
+    std::size_t countListeners() {
+        sf::Event event{};
+        event.type = sf::Event::KeyPressed;
+        TeardownListener::eventsHandled = 0;
+        EventSystem::getInstance().dispatchEvent(event);
+        return TeardownListener::eventsHandled;
+    }
+
+    std::vector<GameObject*> createListenerScene(std::size_t count) {
+        QuietOutput quiet;
+        std::vector<GameObject*> objects;
+        objects.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            GameObject* object = GameObject::create(sf::Vector2f(0.0f, 0.0f), "listener");
+            object->addComponent<TeardownListener>();
+            objects.push_back(object);
+        }
+        CommandBuffer::getInstance().flush();
+        return objects;
+    }
+}
+
+// 10k objects with four components each, looked up through the type-indexed columns and
+// through the storage ComponentManager used before: a map from object to its component
+// list, scanned with dynamic_cast. LookupD is added last, so the old scan walks the
+// whole list like getComponent<TransformComponent>() used to on most objects.
+bool benchComponentLookup() {
+    constexpr std::size_t ObjectCount = 10000;
+    constexpr int Passes = 100;
+
+    std::vector<GameObject*> objects;
+    std::unordered_map<GameObject*, std::vector<std::unique_ptr<Component>>> oldStorage;
+    {
+        QuietOutput quiet;
+        for (std::size_t i = 0; i < ObjectCount; ++i) {
+            GameObject* object = GameObject::create(sf::Vector2f(0.0f, 0.0f), "lookup");
+            object->addComponent<LookupA>();
+            object->addComponent<LookupB>();
+            object->addComponent<LookupC>();
+            object->addComponent<LookupD>();
+            objects.push_back(object);
+
+            auto& owned = oldStorage[object];
+            owned.push_back(std::make_unique<LookupA>());
+            owned.push_back(std::make_unique<LookupB>());
+            owned.push_back(std::make_unique<LookupC>());
+            owned.push_back(std::make_unique<LookupD>());
+        }
+        CommandBuffer::getInstance().flush();
+    }
+
+    std::size_t oldFound = 0;
+    const double oldMs = measureMilliseconds([&]() {
+        for (int pass = 0; pass < Passes; ++pass) {
+            for (GameObject* object : objects) {
+                auto it = oldStorage.find(object);
+                for (auto& component : it->second) {
+                    if (dynamic_cast<LookupD*>(component.get())) {
+                        ++oldFound;
+                        break;
+                    }
+                }
+            }
+        }
+        });
+
+    std::size_t newFound = 0;
+    const double newMs = measureMilliseconds([&]() {
+        for (int pass = 0; pass < Passes; ++pass) {
+            for (GameObject* object : objects) {
+                if (object->getComponent<LookupD>()) {
+                    ++newFound;
+                }
+            }
+        }
+        });
+
+    const double lookups = static_cast<double>(ObjectCount) * Passes;
+    std::cout << "map + dynamic_cast: " << oldMs << " ms, " << oldMs * 1e6 / lookups << " ns per lookup" << std::endl;
+    std::cout << "type-indexed:       " << newMs << " ms, " << newMs * 1e6 / lookups << " ns per lookup" << std::endl;
+    std::cout << "speedup: " << oldMs / newMs << "x" << std::endl;
+
+    releaseBenchScene();
+    return oldFound == ObjectCount * Passes && newFound == ObjectCount * Passes;
+}
+
+// Scenes of 5k, 10k and 20k event-listening components, torn down the way a scene switch
+// does it (clearScene, one pass over the listeners) and object by object (each listener
+// swap-removed on its own). Both should cost the same per component at every size; the
+// old std::remove per listener made them quadratic. Checks that every listener is gone.
+bool benchSceneTeardown() {
+    constexpr std::size_t SceneSizes[] = { 5000, 10000, 20000 };
+    bool isPassing = true;
+
+    for (std::size_t count : SceneSizes) {
+        createListenerScene(count);
+        const std::size_t subscribed = countListeners();
+        if (subscribed != count) {
+            std::cout << "Only " << subscribed << " of " << count << " listeners subscribed" << std::endl;
+            isPassing = false;
+        }
+        const double sceneMs = measureMilliseconds([]() { releaseBenchScene(); });
+        if (const std::size_t left = countListeners(); left != 0) {
+            std::cout << left << " listeners left after clearScene" << std::endl;
+            isPassing = false;
+        }
+
+        std::vector<GameObject*> objects = createListenerScene(count);
+        const double objectMs = measureMilliseconds([&objects]() {
+            QuietOutput quiet;
+            for (GameObject* object : objects) {
+                object->destroy();
+            }
+            CommandBuffer::getInstance().flush();
+            });
+        if (const std::size_t left = countListeners(); left != 0) {
+            std::cout << left << " listeners left after destroying each object" << std::endl;
+            isPassing = false;
+        }
+
+        std::cout << count << " components: clearScene " << sceneMs << " ms (" << sceneMs * 1e6 / count
+            << " ns each), destroy each " << objectMs << " ms (" << objectMs * 1e6 / count << " ns each)" << std::endl;
+    }
+    return isPassing;
+}
@@ -0,0 +1,96 @@
+#include "Bench.h"
+#include "GameObject.h"
+#include "Component.h"
+#include "Systems.h"
+#include "GameplayEvents.h"
+#include <vector>
+
+namespace {
+    constexpr float StartingHealth = 1000000.0f;
+    // Impacts land on this many entities, however big the scene is
+    constexpr std::size_t HitEntityCount = 400;
+    constexpr int Steps = 100;
+
+    std::vector<GameObject*> createBreakables(std::size_t count) {
+        QuietOutput quiet;
+        std::vector<GameObject*> objects;
+        objects.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            GameObject* object = GameObject::create(sf::Vector2f(0.0f, 0.0f), "breakable");
+            object->addComponent<BreakableComponent>(StartingHealth);
+            objects.push_back(object);
+        }
+        CommandBuffer::getInstance().flush();
+        return objects;
+    }
+
+    // Runs Steps physics steps' worth of damage with the given number of PostSolve impacts
+    // each, spread over the first HitEntityCount objects. Returns the time per step and
+    // whether every impulse ended up as lost health on both bodies.
+    bool runImpacts(const std::vector<GameObject*>& objects, std::size_t impactsPerStep, double& msPerStep) {
+        std::vector<ContactEvent> events(impactsPerStep);
+        for (std::size_t i = 0; i < impactsPerStep; ++i) {
+            // (7i + 1) - i is odd, so a body never hits itself
+            events[i] = ContactEvent{ ContactEvent::Type::PostSolve,
+                objects[i % HitEntityCount]->getEntity(),
+                objects[(i * 7 + 1) % HitEntityCount]->getEntity(), 1.0f };
+        }
+
+        DamageSystem damageSystem;
+        damageSystem.setDamagePerImpulse(1.0f);
+        auto& gameplayEvents = GameplayEventQueue::getInstance();
+        const double milliseconds = measureMilliseconds([&]() {
+            for (int step = 0; step < Steps; ++step) {
+                for (const ContactEvent& event : events) {
+                    damageSystem.accumulate(event);
+                }
+                damageSystem.apply();
+                gameplayEvents.dispatch();
+            }
+            });
+        msPerStep = milliseconds / Steps;
+
+        double healthLost = 0.0;
+        for (GameObject* object : objects) {
+            auto breakable = object->getComponent<BreakableComponent>();
+            healthLost += StartingHealth - breakable->getHealth();
+            breakable->setHealth(StartingHealth);
+        }
+        return healthLost == 2.0 * impactsPerStep * Steps;
+    }
+}
+
+// Feeds synthetic PostSolve impulses through DamageSystem and the gameplay event queue.
+// The cost should follow the number of impacts: it grows with the impacts per step and
+// stays flat as the scene grows around the same hits. Also checks no damage is lost.
+bool benchImpulseDamage() {
+    constexpr std::size_t ImpactCounts[] = { 500, 1000, 2000, 4000, 8000 };
+    constexpr std::size_t SceneSizes[] = { 1000, 10000, 50000 };
+    constexpr std::size_t FixedSceneSize = 10000;
+    constexpr std::size_t FixedImpacts = 2000;
+    bool isPassing = true;
+    double msPerStep = 0.0;
+
+    std::vector<GameObject*> objects = createBreakables(FixedSceneSize);
+    for (std::size_t impacts : ImpactCounts) {
+        if (!runImpacts(objects, impacts, msPerStep)) {
+            std::cout << "Damage went missing with " << impacts << " impacts per step" << std::endl;
+            isPassing = false;
+        }
+        std::cout << FixedSceneSize << " breakables, " << impacts << " impacts per step: " << msPerStep * 1000.0
+            << " us per step (" << msPerStep * 1e6 / impacts << " ns per impact)" << std::endl;
+    }
+    releaseBenchScene();
+
+    for (std::size_t count : SceneSizes) {
+        objects = createBreakables(count);
+        if (!runImpacts(objects, FixedImpacts, msPerStep)) {
+            std::cout << "Damage went missing with " << count << " breakables" << std::endl;
+            isPassing = false;
+        }
+        std::cout << count << " breakables, " << FixedImpacts << " impacts per step: " << msPerStep * 1000.0
+            << " us per step" << std::endl;
+        releaseBenchScene();
+    }
+    return isPassing;
+}
@@ -0,0 +1,92 @@
+#include "Bench.h"
+#include "JobSystem.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+    // A synthetic scene laid out like the engine's transform storage: one array per field
+    struct SyntheticScene {
+        explicit SyntheticScene(std::size_t count)
+            : x(count), y(count), velocityX(count), velocityY(count), rotation(count), matrix(count * 4) {
+            for (std::size_t i = 0; i < count; ++i) {
+                x[i] = static_cast<float>(i % 1000);
+                y[i] = static_cast<float>(i / 1000);
+                velocityX[i] = static_cast<float>(i % 7) - 3.0f;
+                velocityY[i] = static_cast<float>(i % 5) - 2.0f;
+                rotation[i] = 0.0f;
+            }
+        }
+
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> rotation;
+        // 2x2 rotation per entity, as render prep builds for the draw calls
+        std::vector<float> matrix;
+    };
+
+    // One frame: integrate and bounce off the bounds, then build each entity's rotation.
+    // Every entity only touches its own slots, so the result can't depend on the split.
+    void stepFrame(JobSystem& jobSystem, SyntheticScene& scene, float deltaTime) {
+        constexpr std::size_t MinChunk = 1024;
+        const std::size_t count = scene.x.size();
+        jobSystem.parallelFor(count, MinChunk, [&scene, deltaTime](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                scene.velocityY[i] += 9.8f * deltaTime;
+                scene.x[i] += scene.velocityX[i] * deltaTime;
+                scene.y[i] += scene.velocityY[i] * deltaTime;
+                if (scene.y[i] > 1000.0f) {
+                    scene.y[i] = 1000.0f;
+                    scene.velocityY[i] = -scene.velocityY[i] * 0.8f;
+                }
+                scene.rotation[i] += std::atan2(scene.velocityY[i], scene.velocityX[i] + 0.001f) * deltaTime;
+            }
+        });
+        jobSystem.parallelFor(count, MinChunk, [&scene](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const float cosine = std::cos(scene.rotation[i]);
+                const float sine = std::sin(scene.rotation[i]);
+                scene.matrix[i * 4 + 0] = cosine;
+                scene.matrix[i * 4 + 1] = -sine;
+                scene.matrix[i * 4 + 2] = sine;
+                scene.matrix[i * 4 + 3] = cosine;
+            }
+        });
+    }
+}
+
+// 50k entities stepped for 200 frames on pools of 0 up to defaultWorkerCount() workers,
+// so 1 to N threads counting the calling one. Prints the frame time and the speedup
+// over the single-threaded run, and checks every run ends in the same scene.
+bool benchJobSystemScaling() {
+    constexpr std::size_t EntityCount = 50000;
+    constexpr int Frames = 200;
+    constexpr float FrameTime = 1.0f / 60.0f;
+    bool isPassing = true;
+
+    std::vector<float> expectedMatrix;
+    double singleThreaded = 0.0;
+    for (std::size_t workers = 0; workers <= JobSystem::defaultWorkerCount(); ++workers) {
+        JobSystem jobSystem(workers);
+        SyntheticScene scene(EntityCount);
+        const double milliseconds = measureMilliseconds([&]() {
+            for (int frame = 0; frame < Frames; ++frame) {
+                stepFrame(jobSystem, scene, FrameTime);
+            }
+        });
+
+        const double perFrame = milliseconds / Frames;
+        if (workers == 0) {
+            singleThreaded = perFrame;
+            expectedMatrix = scene.matrix;
+        }
+        else if (scene.matrix != expectedMatrix) {
+            std::cout << workers + 1 << " threads ended in a different scene" << std::endl;
+            isPassing = false;
+        }
+        std::cout << workers + 1 << " threads: " << perFrame << " ms per frame ("
+            << singleThreaded / perFrame << "x)" << std::endl;
+    }
+    return isPassing;
+}
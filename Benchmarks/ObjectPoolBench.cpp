@@ -0,0 +1,166 @@
+#include "Bench.h"
+#include "ObjectPool.h"
+#include "GameObject.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+    // Same fields as a GameObject, without the entity and logging side effects
+    struct PooledObject {
+        explicit PooledObject(std::uint32_t id) : name("Object " + std::to_string(id)), entity(id) {}
+        float position[2] = { 0.0f, 0.0f };
+        std::string name;
+        bool isDestroyed = false;
+        std::uint32_t entity;
+        const void* prefab = nullptr;
+    };
+
+    // A scene's worth of plain data, where releaseAll doesn't visit any slots
+    struct TrivialObject {
+        float position[2];
+        std::uint32_t entity;
+    };
+
+    // Fixed sequence so both allocators see the same churn
+    std::uint32_t nextRandom(std::uint32_t& state) {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+}
+
+// 100k create/destroy cycles against a working set of 1,000 live objects, which is the
+// pattern split birds, respawns and debris give: pick a random live object, destroy it,
+// create its replacement. Then whole-scene teardown of 100k objects, released one by
+// one and through releaseAll. The pool must not grow past the working set while churning.
+bool benchObjectPool() {
+    constexpr std::size_t Cycles = 100000;
+    constexpr std::size_t WorkingSet = 1000;
+    constexpr std::size_t SceneSize = 100000;
+    bool isPassing = true;
+
+    ObjectPool<PooledObject> pool;
+    std::vector<PooledObject*> live(WorkingSet);
+    std::uint32_t seed = 1;
+    for (std::size_t i = 0; i < WorkingSet; ++i) {
+        live[i] = pool.create(static_cast<std::uint32_t>(i));
+    }
+    const std::size_t workingCapacity = pool.capacity();
+    const double pooledChurn = measureMilliseconds([&]() {
+        for (std::size_t i = 0; i < Cycles; ++i) {
+            PooledObject*& victim = live[nextRandom(seed) % WorkingSet];
+            pool.release(victim);
+            victim = pool.create(static_cast<std::uint32_t>(i));
+        }
+    });
+    for (PooledObject* object : live) {
+        pool.release(object);
+    }
+
+    seed = 1;
+    for (std::size_t i = 0; i < WorkingSet; ++i) {
+        live[i] = new PooledObject(static_cast<std::uint32_t>(i));
+    }
+    const double heapChurn = measureMilliseconds([&]() {
+        for (std::size_t i = 0; i < Cycles; ++i) {
+            PooledObject*& victim = live[nextRandom(seed) % WorkingSet];
+            delete victim;
+            victim = new PooledObject(static_cast<std::uint32_t>(i));
+        }
+    });
+    for (PooledObject* object : live) {
+        delete object;
+    }
+
+    std::cout << Cycles << " create/destroy cycles: pool " << pooledChurn << " ms, new/delete "
+        << heapChurn << " ms (" << heapChurn / pooledChurn << "x)" << std::endl;
+    if (pool.capacity() != workingCapacity) {
+        std::cout << "Pool grew from " << workingCapacity << " to " << pool.capacity() << " slots while churning" << std::endl;
+        isPassing = false;
+    }
+
+    // Whole-scene teardown
+    std::vector<PooledObject*> scene(SceneSize);
+    for (std::size_t i = 0; i < SceneSize; ++i) {
+        scene[i] = pool.create(static_cast<std::uint32_t>(i));
+    }
+    const double pooledRelease = measureMilliseconds([&]() {
+        for (PooledObject* object : scene) {
+            pool.release(object);
+        }
+    });
+    for (std::size_t i = 0; i < SceneSize; ++i) {
+        scene[i] = pool.create(static_cast<std::uint32_t>(i));
+    }
+    const double pooledReleaseAll = measureMilliseconds([&]() { pool.releaseAll(); });
+    if (pool.liveCount() != 0) {
+        std::cout << "releaseAll left " << pool.liveCount() << " live objects" << std::endl;
+        isPassing = false;
+    }
+
+    for (std::size_t i = 0; i < SceneSize; ++i) {
+        scene[i] = new PooledObject(static_cast<std::uint32_t>(i));
+    }
+    const double heapRelease = measureMilliseconds([&]() {
+        for (PooledObject* object : scene) {
+            delete object;
+        }
+    });
+
+    ObjectPool<TrivialObject> trivialPool;
+    for (std::size_t i = 0; i < SceneSize; ++i) {
+        trivialPool.create(TrivialObject{ { 0.0f, 0.0f }, static_cast<std::uint32_t>(i) });
+    }
+    const double trivialReleaseAll = measureMilliseconds([&]() { trivialPool.releaseAll(); });
+
+    std::cout << SceneSize << " object teardown: pool release " << pooledRelease << " ms, releaseAll "
+        << pooledReleaseAll << " ms, delete " << heapRelease << " ms" << std::endl;
+    std::cout << SceneSize << " trivially destructible objects, releaseAll: " << trivialReleaseAll << " ms" << std::endl;
+    return isPassing;
+}
+
+// The same churn through the engine: GameObject::create and destroy, applied by the
+// CommandBuffer flush at the end of each frame. 1,000 frames replace 100 of the 1,000
+// live objects each, 100k create/destroy cycles in all. Logging is detached, so this
+// times the pool, the entity manager and the flush.
+bool benchGameObjectChurn() {
+    constexpr std::size_t Frames = 1000;
+    constexpr std::size_t ChurnPerFrame = 100;
+    constexpr std::size_t WorkingSet = 1000;
+    auto& commandBuffer = CommandBuffer::getInstance();
+
+    std::vector<GameObject*> live(WorkingSet);
+    std::uint32_t seed = 1;
+    double milliseconds = 0.0;
+    {
+        QuietOutput quiet;
+        for (GameObject*& object : live) {
+            object = GameObject::create(sf::Vector2f(0.0f, 0.0f), "churn");
+        }
+        commandBuffer.flush();
+
+        milliseconds = measureMilliseconds([&]() {
+            for (std::size_t frame = 0; frame < Frames; ++frame) {
+                for (std::size_t i = 0; i < ChurnPerFrame; ++i) {
+                    // A slot picked twice in a frame destroys a replacement before it has
+                    // joined the object list; the flush inserts and drops it in one go
+                    GameObject*& victim = live[nextRandom(seed) % WorkingSet];
+                    victim->destroy();
+                    victim = GameObject::create(sf::Vector2f(0.0f, 0.0f), "churn");
+                }
+                commandBuffer.flush();
+            }
+            });
+    }
+
+    const std::size_t cycles = Frames * ChurnPerFrame;
+    const std::size_t liveObjects = GameObject::getAllObjects().size();
+    std::cout << cycles << " GameObject create/destroy cycles: " << milliseconds << " ms, "
+        << milliseconds * 1e6 / cycles << " ns per cycle" << std::endl;
+    releaseBenchScene();
+    if (liveObjects != WorkingSet) {
+        std::cout << liveObjects << " objects alive after churning, expected " << WorkingSet << std::endl;
+        return false;
+    }
+    return true;
+}
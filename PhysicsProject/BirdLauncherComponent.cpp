@@ -5,7 +5,7 @@
 #include <memory> // for std::unique_ptr
 
 BirdLauncherComponent::BirdLauncherComponent(sf::RenderWindow* window, Box2DWorld* world, const sf::Vector2f& spawnPosition, BirdCreationFunction createBirdFunction, const std::string& spritePath)
-    : m_window(window), m_world(world), m_spawnPosition(spawnPosition), m_anchorPosition(spawnPosition), m_createBirdFunction(createBirdFunction), m_spritePath(spritePath), m_bird(nullptr), m_isDragging(false)
+    : m_window(window), m_world(world), m_spawnPosition(spawnPosition), m_anchorPosition(spawnPosition), m_createBirdFunction(createBirdFunction), m_spritePath(spritePath), m_isDragging(false), m_slingJoint(nullptr)
     {
         m_resetTimer = std::make_unique<TimerComponent>(3.0f);
 
@@ -13,13 +13,14 @@ BirdLauncherComponent::BirdLauncherComponent(sf::RenderWindow* window, Box2DWorl
 
 BirdLauncherComponent::~BirdLauncherComponent()
 {
-    if (m_bird) {
-        auto ability = m_bird->getComponent<AbilityComponent>();
+    GameObject* bird = getBird();
+    if (bird) {
+        auto ability = bird->getComponent<AbilityComponent>();
         if (ability) {
             ability->reset();
         }
-        m_bird->destroy();
-        m_bird = nullptr;
+        bird->destroy();
+        m_bird = Entity{};
     }
 
 }
@@ -32,7 +33,8 @@ void BirdLauncherComponent::start() {
 
 }
 void BirdLauncherComponent::update(float deltaTime)  {
-    if (!m_bird) {
+    GameObject* bird = getBird();
+    if (!bird) {
         return;
     }
  
@@ -51,11 +53,12 @@ void BirdLauncherComponent::update(float deltaTime)  {
 
 }
 void BirdLauncherComponent::handleEvent(const sf::Event& event)  {
-    if (!m_bird) {
+    GameObject* bird = getBird();
+    if (!bird) {
         return;
     }
 
-    auto rigidBody = m_bird->getComponent<RigidBodyComponent>();
+    auto rigidBody = bird->getComponent<RigidBodyComponent>();
     if (!rigidBody) {
         std::cout << "RigidBodyComponent not found in handleEvent()" << std::endl;
         return;
@@ -70,11 +73,11 @@ void BirdLauncherComponent::handleEvent(const sf::Event& event)  {
     }
     else if (event.type == sf::Event::MouseButtonReleased) {
         if (event.mouseButton.button == sf::Mouse::Left && m_isDragging) {
-            auto transform = m_bird->getComponent<TransformComponent>();
+            auto transform = bird->getComponent<TransformComponent>();
             if (transform) {
                 float distance = std::sqrt(
-                    std::pow(transform->position.x - m_launchPosition.x, 2) +
-                    std::pow(transform->position.y - m_launchPosition.y, 2)
+                    std::pow(transform->getPosition().x - m_launchPosition.x, 2) +
+                    std::pow(transform->getPosition().y - m_launchPosition.y, 2)
                 );
 
             //    if (distance > 50.0f) { 
@@ -96,14 +99,15 @@ void BirdLauncherComponent::spawnBird() {
     std::cout << "BirdLauncherComponent::spawnBird() called" << std::endl;
     std::cout << "Spawning bird at position: " << m_spawnPosition.x << ", " << m_spawnPosition.y << std::endl;
     m_birdLaunched = false;
-    m_bird = m_createBirdFunction(m_spawnPosition, m_spritePath);
-    if (!m_bird) {
+    GameObject* bird = m_createBirdFunction(m_spawnPosition, m_spritePath);
+    if (!bird) {
         std::cout << "Error: Failed to create bird" << std::endl;
         return;
     }
+    m_bird = bird->getEntity();
     std::cout << "Bird created successfully" << std::endl;
 
-    auto rigidBody = m_bird->getComponent<RigidBodyComponent>();
+    auto rigidBody = bird->getComponent<RigidBodyComponent>();
     if (!rigidBody) {
         std::cout << "Error: RigidBodyComponent not found on bird" << std::endl;
         return;
@@ -117,7 +121,7 @@ void BirdLauncherComponent::spawnBird() {
     rigidBody->GetBody()->SetTransform(rigidBody->GetBody()->GetPosition(), 0);
     rigidBody->GetBody()->SetLinearVelocity(b2Vec2(0, 0));
     rigidBody->GetBody()->SetAngularVelocity(0);
-    m_bird->getComponent<RigidBodyComponent>()->toggleGravity(false);
+    bird->getComponent<RigidBodyComponent>()->toggleGravity(false);
     rigidBody->toggleGravity(false);
 
     std::cout << "Calling createSlingJoint()..." << std::endl;
@@ -128,12 +132,13 @@ void BirdLauncherComponent::spawnBird() {
 
 
 void BirdLauncherComponent::createSlingJoint() {
-    if (!m_bird) {
+    GameObject* bird = getBird();
+    if (!bird) {
         std::cout << "Error: No bird to attach sling joint to." << std::endl;
         return;
     }
 
-    auto rigidBody = m_bird->getComponent<RigidBodyComponent>();
+    auto rigidBody = bird->getComponent<RigidBodyComponent>();
     if (!rigidBody) {
         std::cout << "Error: RigidBodyComponent not found on bird." << std::endl;
         return;
@@ -179,10 +184,11 @@ void BirdLauncherComponent::createSlingJoint() {
 }
 
 void BirdLauncherComponent::updateBirdPosition(const sf::Vector2f& mousePos) {
-    if (!m_bird) return;
+    GameObject* bird = getBird();
+    if (!bird) return;
 
-    auto transform = m_bird->getComponent<TransformComponent>();
-    auto rigidBody = m_bird->getComponent<RigidBodyComponent>();
+    auto transform = bird->getComponent<TransformComponent>();
+    auto rigidBody = bird->getComponent<RigidBodyComponent>();
     if (!transform || !rigidBody || !rigidBody->GetBody()) return;
 
     // Calculate the direction from anchor to mouse
@@ -196,17 +202,16 @@ void BirdLauncherComponent::updateBirdPosition(const sf::Vector2f& mousePos) {
 
     // Set the bird's position
     sf::Vector2f newPosition = m_anchorPosition + direction;
-    transform->position = newPosition;
-
-    // Update the physics body position
-    rigidBody->GetBody()->SetTransform(b2Vec2(newPosition.x / 30.0f, newPosition.y / 30.0f), rigidBody->GetBody()->GetAngle());
+    // Set the transform, which also moves the physics body
+    transform->setPosition(newPosition.x, newPosition.y);
     rigidBody->GetBody()->SetLinearVelocity(b2Vec2(0, 0));  // Reset velocity while dragging
 }
 
 void BirdLauncherComponent::launchBird(const sf::Vector2f& releasePos) {
-    if (!m_bird) return;
+    GameObject* bird = getBird();
+    if (!bird) return;
 
-    auto rigidBody = m_bird->getComponent<RigidBodyComponent>();
+    auto rigidBody = bird->getComponent<RigidBodyComponent>();
     if (!rigidBody) return;
     rigidBody->toggleGravity(true);
     // Calculate launch vector
@@ -221,7 +226,7 @@ void BirdLauncherComponent::launchBird(const sf::Vector2f& releasePos) {
     }
 
     // Store launch position for distance checking
-    m_launchPosition = m_bird->getComponent<TransformComponent>()->position;
+    m_launchPosition = bird->getComponent<TransformComponent>()->getPosition();
 
     // Remove the distance joint
     if (m_slingJoint) {
@@ -230,7 +235,7 @@ void BirdLauncherComponent::launchBird(const sf::Vector2f& releasePos) {
     }
     m_resetTimer->start();  
     m_birdLaunched = true;
-    auto ability = m_bird->getComponent<AbilityComponent>();
+    auto ability = bird->getComponent<AbilityComponent>();
     if (ability) {
         std::cout << "DoubleMassAbility found and onLaunch called" << std::endl;
         ability->onLaunch();
@@ -238,17 +243,19 @@ void BirdLauncherComponent::launchBird(const sf::Vector2f& releasePos) {
     else {
         std::cout << "DoubleMassAbility not found on the bird" << std::endl;
     }
+    GameplayEventQueue::getInstance().post(GameplayEventType::Launched, bird->getEntity());
     m_thrownBirds++;
 }
 void BirdLauncherComponent::resetLauncher() {
+    GameObject* bird = getBird();
     // Destroy the old bird
-    if (m_bird) {
-        auto ability = m_bird->getComponent<AbilityComponent>();
+    if (bird) {
+        auto ability = bird->getComponent<AbilityComponent>();
         if (ability) {
             ability->reset();
         }
-        m_bird->destroy();
-        m_bird = nullptr;
+        bird->destroy();
+        m_bird = Entity{};
     }
     if (m_thrownBirds < 3) {
         // Spawn a new bird
@@ -257,16 +264,37 @@ void BirdLauncherComponent::resetLauncher() {
     }
 }
 
+void BirdLauncherComponent::restart() {
+    GameObject* bird = getBird();
+    if (bird) {
+        if (m_slingJoint) {
+            m_world->GetWorld()->DestroyJoint(m_slingJoint);
+            m_slingJoint = nullptr;
+        }
+        auto ability = bird->getComponent<AbilityComponent>();
+        if (ability) {
+            ability->reset();
+        }
+        bird->destroy();
+        m_bird = Entity{};
+    }
+    m_isDragging = false;
+    m_thrownBirds = 0;
+    m_resetTimer->reset();
+    spawnBird();
+}
+
 void BirdLauncherComponent::drawRope(sf::RenderWindow& window)
 {
-    if (!m_bird || !m_isDragging) return;
+    GameObject* bird = getBird();
+    if (!bird || !m_isDragging) return;
 
-    auto transform = m_bird->getComponent<TransformComponent>();
+    auto transform = bird->getComponent<TransformComponent>();
     if (!transform) return;
 
     sf::Vertex line[] = {
         sf::Vertex(m_anchorPosition),
-        sf::Vertex(transform->position)
+        sf::Vertex(transform->getDrawPosition())
     };
 
     line[0].color = sf::Color::Green;
@@ -274,3 +302,8 @@ void BirdLauncherComponent::drawRope(sf::RenderWindow& window)
 
     window.draw(line, 2, sf::Lines);
 }
+
+GameObject* BirdLauncherComponent::getBird() const
+{
+    return GameObject::find(m_bird);
+}
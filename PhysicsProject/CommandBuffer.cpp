@@ -0,0 +1,92 @@
+#include "CommandBuffer.h"
+#include "ComponentManager.h"
+#include "EventSystem.h"
+#include <algorithm>
+#include <iostream>
+
+CommandBuffer& CommandBuffer::getInstance() {
+    static CommandBuffer instance;
+    return instance;
+}
+
+void CommandBuffer::recordCreate(GameObject* object) {
+    m_created.push_back(object);
+}
+
+void CommandBuffer::recordDestroy() {
+    ++m_pendingDestroys;
+}
+
+void CommandBuffer::clearScene() {
+    m_clearScene = true;
+    m_clearedCreates = m_created.size();
+    // Listeners added from here on belong to the next scene and survive the release
+    m_clearedScene = EventSystem::getInstance().beginScene();
+}
+
+void CommandBuffer::flush() {
+    // Anything recorded while flushing (destructors, deferred commands) waits for the next flush
+    std::vector<GameObject*> created;
+    created.swap(m_created);
+    std::vector<std::function<void()>> commands;
+    commands.swap(m_commands);
+
+    if (m_clearScene) {
+        releaseScene(created);
+    }
+
+    auto& objects = GameObject::getAllObjects();
+    objects.reserve(objects.size() + created.size());
+    objects.insert(objects.end(), created.begin(), created.end());
+
+    for (auto& command : commands) {
+        command();
+    }
+
+    if (m_pendingDestroys > 0) {
+        m_pendingDestroys = 0;
+        objects.erase(std::remove_if(objects.begin(), objects.end(), [](GameObject* obj) {
+            if (obj->isDestroyed()) {
+                ComponentManager::getInstance().removeComponents(obj);
+                GameObject::release(obj);
+                return true;
+            }
+            return false;
+            }), objects.end());
+    }
+
+    // Hand the (now empty) buffers back so their capacity is reused next frame
+    if (m_created.empty()) {
+        created.clear();
+        m_created.swap(created);
+    }
+    if (m_commands.empty()) {
+        commands.clear();
+        m_commands.swap(commands);
+    }
+}
+
+void CommandBuffer::releaseScene(std::vector<GameObject*>& created) {
+    m_clearScene = false;
+    // Unsubscribe the whole scene at once so the component destructors have nothing to remove
+    EventSystem::getInstance().removeListenersUpTo(m_clearedScene);
+    auto& objects = GameObject::getAllObjects();
+    const std::size_t clearedCreates = std::min(m_clearedCreates, created.size());
+
+    if (clearedCreates == created.size()) {
+        // Nothing survives, tear the components down and give every object back in one go
+        std::cout << "Releasing scene with " << objects.size() + created.size() << " objects" << std::endl;
+        created.clear();
+        GameObject::releaseAll();
+        m_pendingDestroys = 0;
+        return;
+    }
+
+    // Some objects were created after the clear, fall back to the per-object sweep
+    for (auto obj : objects) {
+        obj->destroy();
+    }
+    for (std::size_t i = 0; i < clearedCreates; ++i) {
+        created[i]->destroy();
+    }
+}
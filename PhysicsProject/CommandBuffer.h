@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include "GameObject.h"
+
+// Records structural changes made while systems are running (objects created, destroyed,
+// components added, whole scenes cleared) and applies them in one pass at the sync point
+// in Game::update, so nothing reallocates the object list while it is being iterated.
+class CommandBuffer {
+public:
+    static CommandBuffer& getInstance();
+
+    // Called by GameObject::create, the object joins getAllObjects() at the next flush
+    void recordCreate(GameObject* object);
+    // Called by GameObject::destroy, the object is removed at the next flush
+    void recordDestroy();
+
+    // The component is added at the next flush. The object is looked up again by entity
+    // then, since a scene release earlier in the same flush may have recycled its slot.
+    template<typename T, typename... Args>
+    void addComponent(GameObject* object, Args... args) {
+        m_commands.push_back([entity = object->getEntity(), args...]() mutable {
+            GameObject* target = GameObject::find(entity);
+            if (target && !target->isDestroyed()) {
+                target->addComponent<T>(std::move(args)...);
+            }
+        });
+    }
+
+    // Drops every object that exists now, including ones still waiting to be inserted.
+    // Objects created after this call survive.
+    void clearScene();
+
+    void flush();
+
+private:
+    CommandBuffer() = default;
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    void releaseScene(std::vector<GameObject*>& created);
+
+    std::vector<GameObject*> m_created;
+    std::vector<std::function<void()>> m_commands;
+    std::size_t m_pendingDestroys = 0;
+    bool m_clearScene = false;
+    // How many entries of m_created were already there when clearScene() was called
+    std::size_t m_clearedCreates = 0;
+    // EventSystem scene tag that ended with the last clearScene() call
+    std::uint32_t m_clearedScene = 0;
+};
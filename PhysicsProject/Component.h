@@ -9,10 +9,15 @@
 #include <functional>
 #include "Systems.h"
 #include "EventSystem.h"
+#include "ComponentType.h"
 #include "ComponentManager.h"
 #include "Box2DWorld.h"
+#include "TransformStorage.h"
+#include "TextureCache.h"
+#include "GameplayEvents.h"
 #include "box2d/box2d.h"
 #include <memory> 
+#include <type_traits>
 //All components are here because it feels easier to work with over having them all on separate files
 class GameObject;
 class ComponentManager;
@@ -27,9 +32,19 @@ public:
 
 class Component {
 public:
+    static constexpr std::uint32_t NoListenerSlot = 0xFFFFFFFFu;
+
+    Component() = default;
+    // Copies (prefab instances) start out unsubscribed, the slot belongs to the original
+    Component(const Component& other) : m_owner(other.m_owner) {}
+    Component& operator=(const Component& other) {
+        m_owner = other.m_owner;
+        return *this;
+    }
     virtual ~Component() {
-        EventSystem::getInstance().removeListener(this);
-        
+        if (m_listenerSlot != NoListenerSlot) {
+            EventSystem::getInstance().removeListener(this);
+        }
     }
     virtual void update(float deltaTime) {}
     virtual void init() {}
@@ -39,30 +54,47 @@ public:
 
     void setOwner(GameObject* owner) {
         m_owner = owner;
-        EventSystem::getInstance().addListener(this);
     }
     GameObject* getOwner() const { return m_owner; }
 
 private:
+    friend class EventSystem;
 
     GameObject* m_owner = nullptr;
+    // Set by EventSystem while the component is subscribed
+    std::uint32_t m_listenerSlot = NoListenerSlot;
 };
 
 
+// Position, rotation and scale live in TransformStorage; this is a view over one slot
 class TransformComponent : public Component {
 public:
     TransformComponent(float x, float y);
+    TransformComponent(const TransformComponent& other);
+    TransformComponent& operator=(const TransformComponent&) = delete;
+    ~TransformComponent();
     void setPosition(float x, float y);
     void setRotation(float angle);
     void setScale(float scaleX, float scaleY);
     virtual void start() {}
-    sf::Vector2f position;
-    sf::Vector2f scale;
-    float rotation;
+
+    const sf::Vector2f& getPosition() const { return TransformStorage::getInstance().positions[m_slot]; }
+    const sf::Vector2f& getScale() const { return TransformStorage::getInstance().scales[m_slot]; }
+    float getRotation() const { return TransformStorage::getInstance().rotations[m_slot]; }
+    // Pose to draw, between the last two physics ticks, as of the last publishDrawPoses
+    const sf::Vector2f& getDrawPosition() const { return TransformStorage::getInstance().drawPositions[m_slot]; }
+    float getDrawRotation() const { return TransformStorage::getInstance().drawRotations[m_slot]; }
+
+    void attachBody(b2Body* body);
+    // Makes render prep rebuild this object's shape or sprite on the next frame
+    void markRenderDirty() { TransformStorage::getInstance().markRenderDirty(m_slot); }
+    std::size_t getSlot() const { return m_slot; }
 
 private:
+    friend class TransformStorage;
     void updateBox2DBody();
     RigidBodyComponent* rigidBody;
+    std::size_t m_slot;
 };
 
 class RenderComponent : public Component {
@@ -77,19 +109,23 @@ public:
         if (!transform) {
             return;
         }
-        shape = sf::RectangleShape(sf::Vector2f(60 * transform->scale.x, 60 * transform->scale.y)),
+        shape = sf::RectangleShape(sf::Vector2f(60 * transform->getScale().x, 60 * transform->getScale().y)),
             shape.setFillColor(color);
     }
     void update(float deltaTime) override {
         if (!transform) {
              transform = getOwner()->getComponent<TransformComponent>();
             init();
+            if (transform) {
+                // The shape was rebuilt, place it even if the object is at rest
+                transform->markRenderDirty();
+            }
             //d
             
         }
         
     }
-    TransformComponent* transform;
+    TransformComponent* transform = nullptr;
     sf::RectangleShape shape;
     sf::Color color;
 }; 
@@ -138,13 +174,12 @@ private:
 class SpriteRendererComponent : public Component {
 public:
     virtual void start() {}
+    // The texture is shared through TextureCache, so copying a sprite renderer is cheap
     SpriteRendererComponent(const std::string& texturePath) {
         m_spritePath = texturePath;
-        if (!m_texture.loadFromFile(texturePath)) {
-            throw std::runtime_error("Failed to load texture: " + texturePath);
-        }
-        m_sprite.setTexture(m_texture);
-        m_originalSize = m_texture.getSize();
+        const sf::Texture& texture = TextureCache::getInstance().get(texturePath);
+        m_sprite.setTexture(texture);
+        m_originalSize = texture.getSize();
         m_desiredSize = sf::Vector2f(m_originalSize);
         updateScale();
     }
@@ -176,7 +211,6 @@ private:
         m_sprite.setScale(scaleX, scaleY);
     }
     std::string m_spritePath;
-    sf::Texture m_texture;
     sf::Sprite m_sprite;
     sf::Vector2u m_originalSize;
     sf::Vector2f m_desiredSize;
@@ -201,7 +235,7 @@ public:
         }
 
         b2CircleShape shape;
-        shape.m_radius = m_radius * transform->scale.x; // radius based on scale
+        shape.m_radius = m_radius * transform->getScale().x; // radius based on scale
         shape.m_p = b2Vec2(m_localPosition.x / 30.0f, m_localPosition.y / 30.0f); 
 
         b2FixtureDef fixtureDef;
@@ -216,9 +250,11 @@ public:
         getOwner()->OnCollision(other);
     }
 
+    // Placed from the published draw pose, not the body, which may be mid-step on the
+    // simulation thread. The fixture's shape itself never changes once created.
     void debugDraw(sf::RenderWindow& window) {
-        auto rigidBody = getOwner()->getComponent<RigidBodyComponent>();
-        if (!rigidBody || !rigidBody->GetBody() || !m_fixture) {
+        auto transform = getOwner()->getComponent<TransformComponent>();
+        if (!transform || !m_fixture) {
             return;
         }
 
@@ -227,12 +263,13 @@ public:
             return;
         }
 
-        b2Transform xf = rigidBody->GetBody()->GetTransform();
-        b2Vec2 center = xf.p + b2Mul(xf.q, shape->m_p); 
+        sf::Transform xf;
+        xf.translate(transform->getDrawPosition()).rotate(transform->getDrawRotation());
+        sf::Vector2f center = xf.transformPoint(shape->m_p.x * 30.0f, shape->m_p.y * 30.0f);
         float radius = shape->m_radius;
 
         sf::CircleShape circleShape(radius * 30.0f);
-        circleShape.setPosition(center.x * 30.0f - radius * 30.0f, center.y * 30.0f - radius * 30.0f);
+        circleShape.setPosition(center.x - radius * 30.0f, center.y - radius * 30.0f);
         circleShape.setFillColor(sf::Color::Transparent);
         circleShape.setOutlineColor(sf::Color::Blue);
         circleShape.setOutlineThickness(2);
@@ -245,6 +282,10 @@ private:
     sf::Vector2f m_localPosition;
     b2Fixture* m_fixture = nullptr;
 };
+template<>
+struct ComponentBases<CircleColliderComponent> {
+    using type = TypeList<ICollider>;
+};
 
 
 class BoxColliderComponent : public Component, public ICollider {
@@ -259,7 +300,8 @@ public:
         }
 
         b2PolygonShape shape;
-        shape.SetAsBox((m_width) *transform->scale.x, (m_height) *transform->scale.y, b2Vec2(transform->scale.x, transform->scale.y), 0);
+        const sf::Vector2f& scale = transform->getScale();
+        shape.SetAsBox((m_width) *scale.x, (m_height) *scale.y, b2Vec2(scale.x, scale.y), 0);
 
         b2FixtureDef fixtureDef;
         fixtureDef.shape = &shape;
@@ -273,9 +315,10 @@ public:
         getOwner()->OnCollision(other);
     }
 
+    // Same as the circle: drawn from the published pose, never from the live body
     void debugDraw(sf::RenderWindow& window) {
-        auto rigidBody = getOwner()->getComponent<RigidBodyComponent>();
-        if (!rigidBody || !rigidBody->GetBody() || !m_fixture) {
+        auto transform = getOwner()->getComponent<TransformComponent>();
+        if (!transform || !m_fixture) {
             return;
         }
 
@@ -284,18 +327,14 @@ public:
             return;
         }
 
-        b2Transform xf = rigidBody->GetBody()->GetTransform();
+        sf::Transform xf;
+        xf.translate(transform->getDrawPosition()).rotate(transform->getDrawRotation());
         int32 vertexCount = shape->m_count;
         b2Assert(vertexCount <= b2_maxPolygonVertices);
-        b2Vec2 vertices[b2_maxPolygonVertices];
-
-        for (int32 i = 0; i < vertexCount; ++i) {
-            vertices[i] = b2Mul(xf, shape->m_vertices[i]);
-        }
 
         sf::ConvexShape convexShape(vertexCount);
         for (int32 i = 0; i < vertexCount; ++i) {
-            convexShape.setPoint(i, sf::Vector2f(vertices[i].x * 30.0f, vertices[i].y * 30.0f));
+            convexShape.setPoint(i, xf.transformPoint(shape->m_vertices[i].x * 30.0f, shape->m_vertices[i].y * 30.0f));
         }
 
         convexShape.setFillColor(sf::Color::Transparent);
@@ -311,6 +350,10 @@ private:
  
     b2Fixture* m_fixture = nullptr;
 };
+template<>
+struct ComponentBases<BoxColliderComponent> {
+    using type = TypeList<ICollider>;
+};
 
 class FollowMouseComponent : public Component {
 public:
@@ -330,6 +373,7 @@ public:
         }
     }
 
+    static constexpr EventCategory::Mask EventInterest = EventCategory::MouseButton;
     void handleEvent(const sf::Event& event) override {
         if (event.type == sf::Event::MouseButtonPressed) {
             if (event.mouseButton.button == sf::Mouse::Left) {
@@ -356,10 +400,34 @@ private:
 
 class BreakableComponent : public Component {
 public:
-    BreakableComponent(float maxHealth = 10, float damagePerCollision = 0.0f)
-        : m_maxHealth(maxHealth), m_currentHealth(maxHealth), m_damagePerCollision(damagePerCollision) {}
+    BreakableComponent(float maxHealth = 10)
+        : m_maxHealth(maxHealth), m_currentHealth(maxHealth) {}
     virtual void start() {}
-    void update(float deltaTime) override {
+
+    float getHealth() const { return m_currentHealth; }
+    void setHealth(float health) {
+        m_currentHealth = std::min(health, m_maxHealth);
+        updateTint();
+    }
+
+    // Called by DamageSystem once per physics step with the step's summed damage.
+    // Only posts events, the Destroyed handler removes the object at the sync point.
+    void applyDamage(float damage, Entity source) {
+        if (m_currentHealth <= 0 || damage <= 0) {
+            return;
+        }
+        m_currentHealth = std::max(0.0f, m_currentHealth - damage);
+
+        auto& events = GameplayEventQueue::getInstance();
+        events.post(GameplayEventType::Damage, getOwner()->getEntity(), source, damage);
+        if (m_currentHealth <= 0) {
+            events.post(GameplayEventType::Destroyed, getOwner()->getEntity(), source);
+        }
+    }
+
+    // Tints the sprite or shape from white towards red as health drops. Driven by Damage
+    // events rather than every frame.
+    void updateTint() {
         auto renderComponent = getOwner()->getComponent<RenderComponent>();
         if (renderComponent) {
             updateColor(renderComponent);
@@ -370,23 +438,6 @@ public:
         }
     }
 
-    void onCollision(GameObject* other) {
-        auto rb = other->getComponent<RigidBodyComponent>();
-        float speed = rb->getSpeed();   
-        float mass = rb->GetMass();   
-    
-        m_damagePerCollision = (rb && speed > 3.0f) ? speed * mass : 0;
-        
-        m_currentHealth -= m_damagePerCollision;
-        m_currentHealth = std::max(0.0f, m_currentHealth);
-
-        if (m_currentHealth <= 0) {
-            getOwner()->destroy();
-        }
-       /* std::cout << getOwner()->getName() << " collided with: " << other->getName() << "| I took "<< m_damagePerCollision << " health" << std::endl;*/
-     
-    }
-
 private:
     void updateColor(RenderComponent* renderComponent) {
         float healthPercentage = m_currentHealth / m_maxHealth;
@@ -416,7 +467,6 @@ private:
     }
     float m_maxHealth;
     float m_currentHealth;
-    float m_damagePerCollision;
 };
 class RevoluteJointComponent : public Component {
 public:
@@ -458,8 +508,11 @@ public:
     ~BirdLauncherComponent();
     void start() override;
     void update(float deltaTime) override;
+    static constexpr EventCategory::Mask EventInterest = EventCategory::MouseButton | EventCategory::MouseMove;
     void handleEvent(const sf::Event& event) override;
     void drawRope(sf::RenderWindow& window);
+    // Back to the state right after start(): all birds available and a fresh one on the sling
+    void restart();
 
 private:
     void spawnBird();
@@ -467,13 +520,14 @@ private:
     void updateBirdPosition(const sf::Vector2f& mousePos);
     void launchBird(const sf::Vector2f& releasePos);
     void resetLauncher();
+    GameObject* getBird() const;
     sf::Vector2f m_dragStart;
     sf::Vector2f m_launchPosition;
     sf::RenderWindow* m_window;
     sf::Vector2f m_spawnPosition;
     BirdCreationFunction m_createBirdFunction;
     std::string m_spritePath;
-    GameObject* m_bird;
+    Entity m_bird;
     bool m_isDragging;
     b2MouseJoint* m_mouseJoint;
     b2Joint* m_slingJoint;
@@ -491,10 +545,12 @@ class AbilityComponent : public Component {
 public:
     AbilityComponent() : m_launched(false), m_clickedAfterLaunch(false) {}
 
-    virtual void update(float deltaTime) override {
-
-        if (m_launched && !m_clickedAfterLaunch) {
-            checkForClick();
+    // Clicks come in as events rather than polling the mouse, so recorded input replays them
+    static constexpr EventCategory::Mask EventInterest = EventCategory::MouseButton;
+    void handleEvent(const sf::Event& event) override {
+        if (m_launched && !m_clickedAfterLaunch &&
+            event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            activate();
         }
     }
 
@@ -520,12 +576,11 @@ protected:
     bool m_clickedAfterLaunch;
 
 private:
-    void checkForClick() {
-        if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
+    void activate() {
         std::cout << "click" << std::endl;
-            m_clickedAfterLaunch = true;
-            onClickAfterLaunch();
-        }
+        m_clickedAfterLaunch = true;
+        GameplayEventQueue::getInstance().post(GameplayEventType::AbilityFired, getOwner()->getEntity());
+        onClickAfterLaunch();
     }
 };
 class DoubleMassAbility : public AbilityComponent {
@@ -572,6 +627,10 @@ public:
 private:
     float m_originalMass;
 };
+template<>
+struct ComponentBases<DoubleMassAbility> {
+    using type = TypeList<AbilityComponent>;
+};
 class BoostAbility : public AbilityComponent {
 public:
     BoostAbility(float boostFactor = 2.0f) : m_boostFactor(boostFactor) {}
@@ -603,6 +662,10 @@ public:
 private:
     float m_boostFactor;
 };
+template<>
+struct ComponentBases<BoostAbility> {
+    using type = TypeList<AbilityComponent>;
+};
 class SplitAbility : public AbilityComponent {
 public:
     SplitAbility(int splitCount = 3) : m_splitCount(splitCount) {}
@@ -622,7 +685,7 @@ public:
         auto originalRigidBody = getOwner()->getComponent<RigidBodyComponent>();
 
         if (originalTransform && originalRigidBody) {
-            sf::Vector2f originalPosition = originalTransform->position;
+            sf::Vector2f originalPosition = originalTransform->getPosition();
             sf::Vector2f originalVelocity = originalRigidBody->getVelocity();
 
             for (int i = 0; i < m_splitCount - 1; ++i) {  // -1 because we already have the original
@@ -640,7 +703,7 @@ public:
                 sf::Vector2f newVelocity = rotateVector(originalVelocity, angleOffset);
                 newRigidBody->setVelocity(originalVelocity);
 
-                m_splitBirds.push_back(newBird);
+                m_splitBirds.push_back(newBird->getEntity());
 
                 std::cout << "Created split bird " << i + 1 << " at position (" << originalPosition.x << ", " << originalPosition.y << ")" << std::endl;
             }
@@ -657,7 +720,7 @@ public:
 
 private:
     int m_splitCount;
-    std::vector<GameObject*> m_splitBirds;
+    std::vector<Entity> m_splitBirds;
 
     sf::Vector2f rotateVector(const sf::Vector2f& vector, float angleDegrees) {
         float angleRadians = angleDegrees * 3.14159f / 180.0f;
@@ -667,8 +730,9 @@ private:
     }
 
     void destroySplitBirds() {
-        for (auto bird : m_splitBirds) {
-            if (bird) {
+        for (auto entity : m_splitBirds) {
+            // Split birds may already have been swept, the handle check catches that
+            if (auto bird = GameObject::find(entity)) {
                 bird->destroy();
             }
         }
@@ -676,6 +740,10 @@ private:
         std::cout << "All split birds destroyed" << std::endl;
     }
 };
+template<>
+struct ComponentBases<SplitAbility> {
+    using type = TypeList<AbilityComponent>;
+};
 
 
 enum class TextOrigin {
@@ -728,8 +796,8 @@ public:
     void update(float deltaTime) override {
         auto transform = getOwner()->getComponent<TransformComponent>();
         if (transform) {
-            m_sfText.setPosition(transform->position);
-            m_sfText.setRotation(transform->rotation);
+            m_sfText.setPosition(transform->getPosition());
+            m_sfText.setRotation(transform->getRotation());
         }
     }
 
@@ -783,16 +851,17 @@ public:
     void update(float deltaTime) override {
         auto transform = getOwner()->getComponent<TransformComponent>();
         if (transform) {
-            m_shape.setPosition(transform->position);
-            m_shape.setRotation(transform->rotation);
+            m_shape.setPosition(transform->getPosition());
+            m_shape.setRotation(transform->getRotation());
 
             // Center the text in the button
             sf::FloatRect textBounds = m_sfText.getLocalBounds();
             m_sfText.setOrigin(textBounds.left + textBounds.width / 2.0f, textBounds.top + textBounds.height / 2.0f);
-            m_sfText.setPosition(transform->position);
+            m_sfText.setPosition(transform->getPosition());
         }
     }
 
+    static constexpr EventCategory::Mask EventInterest = EventCategory::MouseButton;
     void handleEvent(const sf::Event& event) override {
         if (event.type == sf::Event::MouseButtonPressed) {
             sf::Vector2f mousePos(event.mouseButton.x, event.mouseButton.y);
@@ -818,6 +887,5 @@ private:
 class PigComponent : public Component {
 public:
     PigComponent() {}
-    virtual void update(float deltaTime) override {}
     // This class is just to identify pigs easier to implement than tags for now
 };
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include "Component.h"
 #include "ComponentManager.h"
 
 ComponentManager& ComponentManager::getInstance() {
@@ -5,16 +6,31 @@ ComponentManager& ComponentManager::getInstance() {
     return instance;
 }
 
-std::vector<Component*> ComponentManager::getAllComponents(GameObject* gameObject)
+ComponentManager::ComponentRange ComponentManager::getAllComponents(GameObject* gameObject)
 {
-    std::vector<Component*> components;
-    auto it = m_components.find(gameObject);
-    if (it != m_components.end()) {
-        for (auto& component : it->second) {
-            components.push_back(component.get());
-        }
+    const std::uint32_t index = gameObject->getEntity().index();
+    if (index < m_components.size()) {
+        return m_components[index].components;
+    }
+    return {};
+}
+
+ComponentManager::ComponentRange ComponentManager::getUpdatables(GameObject* gameObject)
+{
+    const std::uint32_t index = gameObject->getEntity().index();
+    if (index < m_components.size()) {
+        return m_components[index].updatables;
+    }
+    return {};
+}
+
+ComponentManager::ComponentRange ComponentManager::getCollisionHandlers(GameObject* gameObject)
+{
+    const std::uint32_t index = gameObject->getEntity().index();
+    if (index < m_components.size()) {
+        return m_components[index].collisionHandlers;
     }
-    return components;
+    return {};
 }
 
 void ComponentManager::removeComponents(GameObject* gameObject) {
@@ -23,10 +39,39 @@ void ComponentManager::removeComponents(GameObject* gameObject) {
             std::cout << "Warning: Attempting to remove components from null GameObject" << std::endl;
             return;
         }
-        auto it = m_components.find(gameObject);
-        if (it != m_components.end()) {
-            std::cout << "Removing " << it->second.size() << " components from " << gameObject->getName() << std::endl;
-            m_components.erase(it);
+        const std::uint32_t index = gameObject->getEntity().index();
+        if (index < m_components.size() && !m_components[index].components.empty()) {
+            auto& owned = m_components[index];
+            std::cout << "Removing " << owned.components.size() << " components from " << gameObject->getName() << std::endl;
+            // Unlink the slot before the components are destroyed so lookups made from
+            // their destructors never see a half torn down entity
+            const ComponentSignature signature = m_signatures[index];
+            m_signatures[index].reset();
+            for (std::size_t typeId = 0; typeId < m_typeColumns.size(); ++typeId) {
+                if (signature.test(typeId)) {
+                    m_typeColumns[typeId][index] = nullptr;
+                    --m_typeCounts[typeId];
+                }
+            }
+            removeFromQueries(index);
+            m_components[index].updatables.clear();
+            m_components[index].collisionHandlers.clear();
+            // Index through m_components each time, a destructor may create objects and grow it
+            for (std::size_t i = 0; i < m_components[index].components.size(); ++i) {
+                auto& entry = m_components[index];
+                m_pools[entry.poolIds[i]]->release(entry.components[i]);
+            }
+            // Keep the vectors' capacity for the next entity that reuses this slot
+            m_components[index].components.clear();
+            m_components[index].poolIds.clear();
+
+            for (std::size_t typeId = 0; typeId < m_lastRemovedCallbacks.size(); ++typeId) {
+                if (signature.test(typeId) && m_typeCounts[typeId] == 0) {
+                    for (auto& entry : m_lastRemovedCallbacks[typeId]) {
+                        entry.callback();
+                    }
+                }
+            }
         }
         else {
             std::cout << "No components found for " << gameObject->getName() << std::endl;
@@ -39,3 +84,81 @@ void ComponentManager::removeComponents(GameObject* gameObject) {
         std::cout << "Unknown exception in removeComponents" << std::endl;
     }
 }
+
+
+void ComponentManager::removeLastRemoved(CallbackToken token) {
+    if (token.typeId < m_lastRemovedCallbacks.size()) {
+        std::erase_if(m_lastRemovedCallbacks[token.typeId], [&token](const LastRemovedCallback& entry) {
+            return entry.id == token.id;
+            });
+    }
+}
+
+std::size_t ComponentManager::createQuery(const ComponentSignature& mask) {
+    Query query;
+    query.mask = mask;
+    for (std::uint32_t index = 0; index < m_components.size(); ++index) {
+        if (!m_components[index].components.empty() && matchesQuery(query, index)) {
+            query.matches.push_back(m_components[index].components.front()->getOwner());
+            if (index >= query.positions.size()) {
+                query.positions.resize(index + 1, 0);
+            }
+            query.positions[index] = static_cast<std::uint32_t>(query.matches.size());
+        }
+    }
+    m_queries.push_back(std::move(query));
+    return m_queries.size() - 1;
+}
+
+bool ComponentManager::matchesQuery(const Query& query, std::uint32_t entityIndex) const {
+    return entityIndex < m_signatures.size() && (m_signatures[entityIndex] & query.mask) == query.mask;
+}
+
+void ComponentManager::addToQueries(GameObject* gameObject) {
+    const std::uint32_t index = gameObject->getEntity().index();
+    for (auto& query : m_queries) {
+        if (index < query.positions.size() && query.positions[index] != 0) {
+            continue;
+        }
+        if (!matchesQuery(query, index)) {
+            continue;
+        }
+        query.matches.push_back(gameObject);
+        if (index >= query.positions.size()) {
+            query.positions.resize(EntityManager::getInstance().capacity(), 0);
+        }
+        query.positions[index] = static_cast<std::uint32_t>(query.matches.size());
+    }
+}
+
+void ComponentManager::removeFromQueries(std::uint32_t entityIndex) {
+    for (auto& query : m_queries) {
+        if (entityIndex >= query.positions.size() || query.positions[entityIndex] == 0) {
+            continue;
+        }
+        // Swap-remove, then fix up the position of the object that moved
+        const std::uint32_t position = query.positions[entityIndex] - 1;
+        GameObject* last = query.matches.back();
+        query.matches[position] = last;
+        query.positions[last->getEntity().index()] = position + 1;
+        query.matches.pop_back();
+        query.positions[entityIndex] = 0;
+    }
+}
+
+std::vector<ComponentPoolStats> ComponentManager::getPoolStats() const {
+    std::vector<ComponentPoolStats> stats;
+    for (auto& pool : m_pools) {
+        if (pool) {
+            stats.push_back(pool->getStats());
+        }
+    }
+    return stats;
+}
+
+void ComponentManager::printPoolStats() const {
+    for (auto& stats : getPoolStats()) {
+        std::cout << stats.typeName << ": " << stats.liveCount << " live, " << stats.totalAllocated << " allocated, "
+            << stats.reservedBytes << " bytes reserved (" << stats.componentSize << " per component)" << std::endl;
+    }
+}
\ No newline at end of file
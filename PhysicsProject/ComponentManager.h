@@ -1,15 +1,22 @@
 #pragma once
 
-#include <unordered_map>
 #include <vector>
 #include <memory>
-#include <typeindex>
+#include <span>
+#include <stdexcept>
+#include <functional>
+#include "ComponentType.h"
+#include "ComponentPool.h"
+#include "EntityManager.h"
+#include "EventSystem.h"
 #include "Component.h"
 
 class GameObject;
 
 class ComponentManager {
 public:
+    using ComponentRange = std::span<Component* const>;
+
     static ComponentManager& getInstance();
 
     template<typename T, typename... Args>
@@ -18,16 +25,108 @@ public:
     template<typename T>
     T* getComponent(GameObject* gameObject);
 
-    std::vector<Component*> getAllComponents(GameObject* gameObject);
+    // Single bit test against the entity's signature
+    template<typename T>
+    bool hasComponent(GameObject* gameObject) const;
+
+    template<typename... Ts>
+    static ComponentSignature signatureOf();
+
+    // Number of entities that currently have T, kept up to date on add and remove
+    template<typename T>
+    std::size_t count() const;
+
+    // Called from removeComponents when the last entity holding T goes away. Keep the
+    // token and pass it to removeLastRemoved() before whatever the callback uses is gone.
+    struct CallbackToken {
+        std::size_t typeId = 0;
+        std::uint32_t id = 0;
+    };
+    template<typename T>
+    CallbackToken onLastRemoved(std::function<void()> callback);
+    void removeLastRemoved(CallbackToken token);
+
+    // View over the object's own storage, in insertion order. Does not allocate.
+    // Adding components to the same object invalidates it, so don't do that while iterating.
+    ComponentRange getAllComponents(GameObject* gameObject);
+    // Only the components that override update() / onCollision(). Colliders are left out of
+    // the collision list since they forward back into GameObject::OnCollision.
+    ComponentRange getUpdatables(GameObject* gameObject);
+    ComponentRange getCollisionHandlers(GameObject* gameObject);
 
     void removeComponents(GameObject* gameObject);
 
+    // Objects that have every one of Ts. The match list is built on first use and then
+    // kept up to date as components are added and removed.
+    template<typename... Ts>
+    const std::vector<GameObject*>& view();
+
+    // Calls fn(GameObject*, Ts*...) for every object in view<Ts...>()
+    template<typename... Ts, typename Fn>
+    void forEach(Fn&& fn);
+
+    // Calls fn(T&) for every live T straight from its pool, in storage order. Only the
+    // exact type is visited, components stored as a subclass of T are not.
+    template<typename T, typename Fn>
+    void forEachInPool(Fn&& fn);
+
+    // Allocation counts and bytes for every component type that has been pooled so far
+    std::vector<ComponentPoolStats> getPoolStats() const;
+    void printPoolStats() const;
+
 private:
     ComponentManager() = default;
     ComponentManager(const ComponentManager&) = delete;
     ComponentManager& operator=(const ComponentManager&) = delete;
 
-    std::unordered_map<GameObject*, std::vector<std::unique_ptr<Component>>> m_components;
+    template<typename T>
+    ComponentPool<T>& getPool();
+
+    struct Query {
+        ComponentSignature mask;
+        std::vector<GameObject*> matches;
+        // Position + 1 of each entity in matches, 0 when absent. Indexed by Entity::index().
+        std::vector<std::uint32_t> positions;
+    };
+
+    std::size_t createQuery(const ComponentSignature& mask);
+    bool matchesQuery(const Query& query, std::uint32_t entityIndex) const;
+    void addToQueries(GameObject* gameObject);
+    void removeFromQueries(std::uint32_t entityIndex);
+
+    template<typename T>
+    void registerType(std::uint32_t entityIndex, T* component);
+
+    template<typename T, typename... Bases>
+    void registerBases(std::uint32_t entityIndex, T* component, TypeList<Bases...>);
+
+    struct EntityComponents {
+        std::vector<Component*> components;
+        // Pool (ComponentType::id of the concrete type) each component came from
+        std::vector<std::size_t> poolIds;
+        std::vector<Component*> updatables;
+        std::vector<Component*> collisionHandlers;
+    };
+
+    // Components per entity, indexed by Entity::index(). The pools own the memory.
+    std::vector<EntityComponents> m_components;
+    // One pool per concrete component type, indexed by ComponentType::id
+    std::vector<std::unique_ptr<IComponentPool>> m_pools;
+    // One column per ComponentType::id, indexed by Entity::index(). Each entry holds the
+    // entity's component already cast to that type, or nullptr.
+    std::vector<std::vector<void*>> m_typeColumns;
+    // Indexed by Entity::index()
+    std::vector<ComponentSignature> m_signatures;
+    // Indexed by ComponentType::id
+    std::vector<std::size_t> m_typeCounts;
+    struct LastRemovedCallback {
+        std::uint32_t id;
+        std::function<void()> callback;
+    };
+    // Indexed by ComponentType::id
+    std::vector<std::vector<LastRemovedCallback>> m_lastRemovedCallbacks;
+    std::uint32_t m_nextCallbackId = 1;
+    std::vector<Query> m_queries;
 };
 
 // Include template implementations
@@ -4,23 +4,139 @@
 
 template<typename T, typename... Args>
 T* ComponentManager::addComponent(GameObject* gameObject, Args&&... args) {
-    auto component = std::make_unique<T>(std::forward<Args>(args)...);
-    component->setOwner(gameObject);
-    T* ptr = component.get();
-    m_components[gameObject].emplace_back(std::move(component));
+    T* ptr = getPool<T>().create(std::forward<Args>(args)...);
+    ptr->setOwner(gameObject);
+    const std::uint32_t index = gameObject->getEntity().index();
+    if (index >= m_components.size()) {
+        m_components.resize(index + 1);
+    }
+    auto& entry = m_components[index];
+    entry.components.push_back(ptr);
+    entry.poolIds.push_back(ComponentType::id<T>());
+    if constexpr (overridesUpdate<T>) {
+        entry.updatables.push_back(ptr);
+    }
+    if constexpr (overridesOnCollision<T> && !std::is_base_of_v<ICollider, T>) {
+        entry.collisionHandlers.push_back(ptr);
+    }
+    if constexpr (overridesHandleEvent<T>) {
+        EventSystem::getInstance().addListener(ptr, eventInterestOf<T>());
+    }
+    registerType<T>(index, ptr);
+    addToQueries(gameObject);
     return ptr;
 }
 
+template<typename T>
+ComponentPool<T>& ComponentManager::getPool() {
+    const std::size_t typeId = ComponentType::id<T>();
+    if (typeId >= m_pools.size()) {
+        m_pools.resize(ComponentType::count());
+    }
+    if (!m_pools[typeId]) {
+        m_pools[typeId] = std::make_unique<ComponentPool<T>>();
+    }
+    return static_cast<ComponentPool<T>&>(*m_pools[typeId]);
+}
+
 
 template<typename T>
 T* ComponentManager::getComponent(GameObject* gameObject) {
-    auto it = m_components.find(gameObject);
-    if (it != m_components.end()) {
-        for (auto& component : it->second) {
-            if (auto* ptr = dynamic_cast<T*>(component.get())) {
-                return ptr;
-            }
-        }
-    }
-    return nullptr;
+    const std::size_t typeId = ComponentType::id<T>();
+    if (typeId >= m_typeColumns.size()) {
+        return nullptr;
+    }
+    const auto& column = m_typeColumns[typeId];
+    const std::uint32_t index = gameObject->getEntity().index();
+    return index < column.size() ? static_cast<T*>(column[index]) : nullptr;
+}
+
+template<typename T>
+bool ComponentManager::hasComponent(GameObject* gameObject) const {
+    const std::size_t typeId = ComponentType::id<T>();
+    const std::uint32_t index = gameObject->getEntity().index();
+    return index < m_signatures.size() && m_signatures[index].test(typeId);
+}
+
+template<typename... Ts>
+ComponentSignature ComponentManager::signatureOf() {
+    ComponentSignature mask;
+    (mask.set(ComponentType::id<Ts>()), ...);
+    return mask;
+}
+
+template<typename T, typename Fn>
+void ComponentManager::forEachInPool(Fn&& fn) {
+    const std::size_t typeId = ComponentType::id<T>();
+    if (typeId < m_pools.size() && m_pools[typeId]) {
+        static_cast<ComponentPool<T>&>(*m_pools[typeId]).forEach(std::forward<Fn>(fn));
+    }
+}
+
+template<typename T>
+std::size_t ComponentManager::count() const {
+    const std::size_t typeId = ComponentType::id<T>();
+    return typeId < m_typeCounts.size() ? m_typeCounts[typeId] : 0;
+}
+
+template<typename T>
+ComponentManager::CallbackToken ComponentManager::onLastRemoved(std::function<void()> callback) {
+    const std::size_t typeId = ComponentType::id<T>();
+    if (typeId >= m_lastRemovedCallbacks.size()) {
+        m_lastRemovedCallbacks.resize(ComponentType::count());
+    }
+    const std::uint32_t id = m_nextCallbackId++;
+    m_lastRemovedCallbacks[typeId].push_back({ id, std::move(callback) });
+    return { typeId, id };
+}
+
+template<typename T>
+void ComponentManager::registerType(std::uint32_t entityIndex, T* component) {
+    const std::size_t typeId = ComponentType::id<T>();
+    if (typeId >= MaxComponentTypes) {
+        throw std::runtime_error("Too many component types, raise MaxComponentTypes");
+    }
+    if (entityIndex >= m_signatures.size()) {
+        m_signatures.resize(EntityManager::getInstance().capacity());
+    }
+    if (typeId >= m_typeCounts.size()) {
+        m_typeCounts.resize(ComponentType::count(), 0);
+    }
+    if (!m_signatures[entityIndex].test(typeId)) {
+        m_signatures[entityIndex].set(typeId);
+        ++m_typeCounts[typeId];
+    }
+    if (typeId >= m_typeColumns.size()) {
+        m_typeColumns.resize(ComponentType::count());
+    }
+    auto& column = m_typeColumns[typeId];
+    if (entityIndex >= column.size()) {
+        column.resize(EntityManager::getInstance().capacity(), nullptr);
+    }
+    // First component added under a type wins, same as the old lookup order
+    if (!column[entityIndex]) {
+        column[entityIndex] = component;
+    }
+    registerBases(entityIndex, component, typename ComponentBases<T>::type{});
+}
+
+template<typename T, typename... Bases>
+void ComponentManager::registerBases([[maybe_unused]] std::uint32_t entityIndex, [[maybe_unused]] T* component, TypeList<Bases...>) {
+    (registerType<Bases>(entityIndex, static_cast<Bases*>(component)), ...);
+}
+
+template<typename... Ts>
+const std::vector<GameObject*>& ComponentManager::view() {
+    static const std::size_t queryIndex = createQuery(signatureOf<Ts...>());
+    return m_queries[queryIndex].matches;
+}
+
+template<typename... Ts, typename Fn>
+void ComponentManager::forEach(Fn&& fn) {
+    const auto& matches = view<Ts...>();
+    // Index instead of iterating, fn may add objects that grow the match list
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        GameObject* gameObject = matches[i];
+        fn(gameObject, getComponent<Ts>(gameObject)...);
+    }
 }
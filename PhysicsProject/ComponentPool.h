@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <typeinfo>
+#include "ObjectPool.h"
+
+class Component;
+
+struct ComponentPoolStats {
+    const char* typeName;
+    std::size_t componentSize;
+    std::size_t liveCount;
+    std::size_t totalAllocated;
+    std::size_t reservedBytes;
+};
+
+// Type-erased handle so ComponentManager can hand a component back to the pool it came from
+class IComponentPool {
+public:
+    virtual ~IComponentPool() = default;
+    virtual void release(Component* component) = 0;
+    virtual ComponentPoolStats getStats() const = 0;
+};
+
+template<typename T>
+class ComponentPool : public IComponentPool {
+public:
+    template<typename... Args>
+    T* create(Args&&... args) {
+        return m_pool.create(std::forward<Args>(args)...);
+    }
+
+    void release(Component* component) override {
+        m_pool.release(static_cast<T*>(component));
+    }
+
+    ComponentPoolStats getStats() const override {
+        return { typeid(T).name(), sizeof(T), m_pool.liveCount(), m_pool.totalCreated(), m_pool.reservedBytes() };
+    }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) {
+        m_pool.forEach(std::forward<Fn>(fn));
+    }
+
+private:
+    // Components are big (textures, fonts), so keep slabs small
+    ObjectPool<T, 32> m_pool;
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <bitset>
+#include <atomic>
+#include "EventSystem.h"
+
+class Component;
+class GameObject;
+class ICollider;
+
+// Hands out a small dense id per component type so storage can be indexed directly
+// instead of scanning with dynamic_cast. Ids are assigned the first time a type is used.
+class ComponentType {
+public:
+    template<typename T>
+    static std::size_t id() {
+        return typeId<std::remove_cv_t<T>>();
+    }
+
+    static std::size_t count() { return s_nextId.load(); }
+
+private:
+    template<typename T>
+    static std::size_t typeId() {
+        // Different types can be seen for the first time on different workers at once
+        static const std::size_t id = s_nextId.fetch_add(1);
+        return id;
+    }
+
+    static inline std::atomic<std::size_t> s_nextId{ 0 };
+};
+
+// One bit per ComponentType id, set for every type (and registered base) an entity has
+constexpr std::size_t MaxComponentTypes = 64;
+using ComponentSignature = std::bitset<MaxComponentTypes>;
+
+template<typename... Ts>
+struct TypeList {};
+
+// Specialize for a component to list the base types it should also be found under,
+// so getComponent<AbilityComponent>() finds a BoostAbility. Bases of bases are followed.
+template<typename T>
+struct ComponentBases {
+    using type = TypeList<>;
+};
+
+// True when T, or a class between T and Component, overrides the hook. Checked at compile
+// time by ComponentManager::addComponent so only components that do real work are
+// enrolled in the per-frame update, event and collision dispatch lists.
+template<typename T>
+constexpr bool overridesUpdate = !std::is_same_v<decltype(&T::update), void (Component::*)(float)>;
+template<typename T>
+constexpr bool overridesHandleEvent = !std::is_same_v<decltype(&T::handleEvent), void (Component::*)(const sf::Event&)>;
+// Event categories (EventCategory::Mask) a component listens to. Components declare
+//     static constexpr EventCategory::Mask EventInterest = EventCategory::MouseButton;
+// next to their handleEvent override. Without one they get every category.
+template<typename T>
+constexpr auto eventInterestOf() {
+    if constexpr (requires { T::EventInterest; }) {
+        return T::EventInterest;
+    }
+    else {
+        return EventCategory::All;
+    }
+}
+template<typename T>
+constexpr bool overridesOnCollision = !std::is_same_v<decltype(&T::onCollision), void (Component::*)(GameObject*)>;
@@ -0,0 +1,75 @@
+#include "ContactEventBuffer.h"
+#include <algorithm>
+#include <iostream>
+#include <functional>
+
+namespace {
+    Entity entityOf(b2Fixture* fixture) {
+        return Entity::fromId(static_cast<std::uint32_t>(fixture->GetBody()->GetUserData().pointer));
+    }
+}
+
+ContactEventBuffer::ContactEventBuffer(std::size_t capacity) : m_capacity(capacity) {
+    m_events.reserve(capacity);
+    m_stepStarts.reserve(16);
+    m_begunContacts.reserve(capacity);
+}
+
+void ContactEventBuffer::clear() {
+    m_events.clear();
+    m_stepStarts.clear();
+    m_begunContacts.clear();
+    if (m_droppedEvents > 0) {
+        std::cout << "Warning: contact event buffer full, dropped " << m_droppedEvents << " events" << std::endl;
+        m_droppedEvents = 0;
+    }
+}
+
+void ContactEventBuffer::BeginContact(b2Contact* contact) {
+    if (m_begunContacts.size() < m_capacity) {
+        auto it = std::lower_bound(m_begunContacts.begin(), m_begunContacts.end(), contact, std::less<>());
+        if (it == m_begunContacts.end() || *it != contact) {
+            m_begunContacts.insert(it, contact);
+        }
+    }
+    else {
+        // Its PostSolve impulse is lost along with it
+        ++m_droppedEvents;
+    }
+    record(ContactEvent::Type::Begin, contact, 0.0f);
+}
+
+void ContactEventBuffer::EndContact(b2Contact* contact) {
+    // Box2D may reuse the contact's memory for a new contact later in the same step
+    auto it = std::lower_bound(m_begunContacts.begin(), m_begunContacts.end(), contact, std::less<>());
+    if (it != m_begunContacts.end() && *it == contact) {
+        m_begunContacts.erase(it);
+    }
+}
+
+bool ContactEventBuffer::hasBegun(const b2Contact* contact) const {
+    return std::binary_search(m_begunContacts.begin(), m_begunContacts.end(), contact, std::less<>());
+}
+
+void ContactEventBuffer::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) {
+    // Called for every touching contact each step, so bail out early for resting ones
+    if (m_begunContacts.empty() || !hasBegun(contact)) {
+        return;
+    }
+    float normalImpulse = 0.0f;
+    for (int32 i = 0; i < impulse->count; ++i) {
+        normalImpulse = std::max(normalImpulse, impulse->normalImpulses[i]);
+    }
+    if (normalImpulse >= m_impulseThreshold) {
+        record(ContactEvent::Type::PostSolve, contact, normalImpulse);
+    }
+}
+
+void ContactEventBuffer::record(ContactEvent::Type type, b2Contact* contact, float normalImpulse) {
+    if (m_events.size() >= m_capacity) {
+        ++m_droppedEvents;
+        return;
+    }
+    // Store entity handles, not fixtures: bodies can be gone by the time the batch is read
+    m_events.push_back({ type, entityOf(contact->GetFixtureA()), entityOf(contact->GetFixtureB()), normalImpulse });
+}
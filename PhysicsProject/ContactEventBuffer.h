@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "box2d/box2d.h"
+#include "Entity.h"
+
+struct ContactEvent {
+    enum class Type : std::uint8_t {
+        Begin,
+        PostSolve
+    };
+
+    Type type;
+    // Entities of the two bodies, null for static geometry like the walls
+    Entity entityA;
+    Entity entityB;
+    // Largest normal impulse of the contact's points, PostSolve only
+    float normalImpulse;
+};
+
+// Box2D calls back into this from inside b2World::Step. The callbacks only append to a
+// preallocated array; PhysicsSystem reads the batch after every tick and then clears it.
+// With the simulation thread, several ticks are buffered and read back tick by tick
+// through getStepStarts(). PostSolve is only recorded for contacts that began in the same step and
+// pushed harder than the impulse threshold: a resting stack keeps solving the same
+// weight every step, which would otherwise read as a stream of small impacts. Nothing
+// reads contacts ending, so EndContact only forgets the contact for the rest of the step.
+// Neither array grows past its capacity, so a step never allocates; events beyond it are
+// dropped and counted, and the count is reported on the next clear().
+class ContactEventBuffer : public b2ContactListener {
+public:
+    explicit ContactEventBuffer(std::size_t capacity = 1024);
+
+    void BeginContact(b2Contact* contact) override;
+    void EndContact(b2Contact* contact) override;
+    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+
+    const std::vector<ContactEvent>& getEvents() const { return m_events; }
+    // Called before each tick, events from earlier ticks are kept until clear()
+    void beginStep() {
+        m_begunContacts.clear();
+        m_stepStarts.push_back(m_events.size());
+    }
+    // Index into getEvents() where each tick since the last clear() starts
+    const std::vector<std::size_t>& getStepStarts() const { return m_stepStarts; }
+    void clear();
+
+    // PostSolve events weaker than this (in N*s) are not recorded
+    void setImpulseThreshold(float threshold) { m_impulseThreshold = threshold; }
+
+private:
+    void record(ContactEvent::Type type, b2Contact* contact, float normalImpulse);
+    bool hasBegun(const b2Contact* contact) const;
+
+    std::vector<ContactEvent> m_events;
+    std::vector<std::size_t> m_stepStarts;
+    std::size_t m_capacity;
+    std::size_t m_droppedEvents = 0;
+    // Contacts that started touching during the current step. PostSolve runs for every
+    // touching contact and binary searches this. Reserved up front so it never allocates,
+    // and kept sorted on insert since TOI sub-steps interleave Begin and PostSolve.
+    std::vector<const b2Contact*> m_begunContacts;
+    float m_impulseThreshold = 0.75f;
+};
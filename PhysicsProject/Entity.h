@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+
+// 32-bit entity handle: the low bits index a slot in EntityManager and the high bits
+// hold that slot's generation, so a handle to a recycled slot is detected as stale.
+// Generations start at 1, which keeps id 0 free to mean "no entity" (the default
+// value of b2BodyUserData::pointer).
+struct Entity {
+    static constexpr std::uint32_t IndexBits = 20;
+    static constexpr std::uint32_t IndexMask = (1u << IndexBits) - 1;
+    static constexpr std::uint32_t GenerationMask = (1u << (32 - IndexBits)) - 1;
+
+    std::uint32_t id = 0;
+
+    static Entity make(std::uint32_t index, std::uint32_t generation) {
+        return Entity{ (generation << IndexBits) | (index & IndexMask) };
+    }
+    static Entity fromId(std::uint32_t id) { return Entity{ id }; }
+
+    std::uint32_t index() const { return id & IndexMask; }
+    std::uint32_t generation() const { return id >> IndexBits; }
+    bool isNull() const { return id == 0; }
+
+    bool operator==(const Entity& other) const { return id == other.id; }
+    bool operator!=(const Entity& other) const { return id != other.id; }
+};
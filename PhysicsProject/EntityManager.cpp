@@ -0,0 +1,38 @@
+#include "EntityManager.h"
+#include <iostream>
+
+EntityManager& EntityManager::getInstance() {
+    static EntityManager instance;
+    return instance;
+}
+
+Entity EntityManager::create(GameObject* object) {
+    std::uint32_t index;
+    if (!m_freeIndices.empty()) {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    }
+    else {
+        index = static_cast<std::uint32_t>(m_generations.size());
+        if (index > Entity::IndexMask) {
+            std::cout << "Error: Entity limit reached" << std::endl;
+            return Entity{};
+        }
+        m_generations.push_back(1);
+        m_objects.push_back(nullptr);
+    }
+    m_objects[index] = object;
+    return Entity::make(index, m_generations[index]);
+}
+
+void EntityManager::destroy(Entity entity) {
+    if (!isAlive(entity)) {
+        return;
+    }
+    const std::uint32_t index = entity.index();
+    m_objects[index] = nullptr;
+    // Skip generation 0 on wrap so a recycled slot never produces the null id
+    std::uint32_t generation = (m_generations[index] + 1) & Entity::GenerationMask;
+    m_generations[index] = generation == 0 ? 1 : generation;
+    m_freeIndices.push_back(index);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Entity.h"
+
+class GameObject;
+
+// Owns the entity slots. Looking up an entity is an array index plus a generation compare.
+class EntityManager {
+public:
+    static EntityManager& getInstance();
+
+    Entity create(GameObject* object);
+    void destroy(Entity entity);
+
+    bool isAlive(Entity entity) const {
+        const std::uint32_t index = entity.index();
+        return !entity.isNull() && index < m_generations.size() && m_generations[index] == entity.generation();
+    }
+    // Returns nullptr for null or stale handles
+    GameObject* getObject(Entity entity) const {
+        return isAlive(entity) ? m_objects[entity.index()] : nullptr;
+    }
+    // One past the highest slot index ever handed out
+    std::size_t capacity() const { return m_generations.size(); }
+
+private:
+    EntityManager() = default;
+    EntityManager(const EntityManager&) = delete;
+    EntityManager& operator=(const EntityManager&) = delete;
+
+    std::vector<std::uint32_t> m_generations;
+    std::vector<GameObject*> m_objects;
+    std::vector<std::uint32_t> m_freeIndices;
+};
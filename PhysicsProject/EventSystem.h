@@ -1,17 +1,59 @@
 #pragma once
 #include <SFML/Window/Event.hpp>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
 class Component;
 
+// Groups of sf::Event types a component can subscribe to
+namespace EventCategory {
+    using Mask = std::uint8_t;
+    constexpr Mask MouseButton = 1 << 0; // presses, releases and the wheel
+    constexpr Mask MouseMove = 1 << 1;   // moves, entering and leaving the window
+    constexpr Mask Key = 1 << 2;         // key presses, releases and text input
+    constexpr Mask Window = 1 << 3;      // everything else: close, resize, focus, joystick
+    constexpr Mask All = MouseButton | MouseMove | Key | Window;
+    constexpr std::size_t Count = 4;
+}
+
 class EventSystem {
 public:
     static EventSystem& getInstance();
-    void addListener(Component* component);
+    // ComponentManager enrolls components that override handleEvent, for the categories
+    // named by their EventInterest constant (all of them if it isn't declared)
+    void addListener(Component* component, EventCategory::Mask categories = EventCategory::All);
+    // O(1): the component remembers its slot and each list entry is swap-removed
     void removeListener(Component* component);
+    // Only the listeners subscribed to the event's category are called
     void dispatchEvent(const sf::Event& event);
 
+    // Listeners are tagged with the scene that was current when they were added. Starting
+    // a new scene returns the tag of the one that just ended.
+    std::uint32_t beginScene();
+    // Drops every listener tagged with scene or earlier in one linear pass, so a scene
+    // teardown doesn't pay for a removal per component
+    void removeListenersUpTo(std::uint32_t scene);
+
+    static std::size_t categoryIndex(sf::Event::EventType type);
+
 private:
     EventSystem() = default;
-    std::vector<Component*> m_listeners;
+
+    static constexpr std::uint32_t NoPosition = 0xFFFFFFFFu;
+
+    struct ListenerSlot {
+        // nullptr while the slot is on the free list
+        Component* component;
+        std::uint32_t scene;
+        // Index into m_listeners[category] for each category, or NoPosition
+        std::uint32_t positions[EventCategory::Count];
+    };
+
+    std::vector<Component*> m_listeners[EventCategory::Count];
+    // Slot of each entry in m_listeners, so the moved entry can be fixed up on swap-remove
+    std::vector<std::uint32_t> m_listenerSlots[EventCategory::Count];
+    std::vector<ListenerSlot> m_slots;
+    std::vector<std::uint32_t> m_freeSlots;
+    std::uint32_t m_scene = 0;
 };
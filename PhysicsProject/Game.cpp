@@ -3,24 +3,101 @@
 #include "Systems.h"
 #include "EventSystem.h"
 #include "LevelManager.h"
+#include "CommandBuffer.h"
+#include "TextureCache.h"
+#include "GameplayEvents.h"
 #include <algorithm>
 
-Game::Game()
-    : m_window(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "GameObject Game"),
+Game::Game(const GameOptions& options)
+    : m_options(options),
+    m_isRunning(true),
     m_currentScene(SceneType::MAIN_MENU),
     m_isLoseScreenActive(false),
     m_isGameCompleteScreenActive(false),
-    m_bird(nullptr)
+    m_isBuildingScene(false),
+    m_isRetryPending(false),
+    m_bird(nullptr),
+    m_loseTextObject(nullptr),
+    m_retryButtonObject(nullptr)
 {   
     m_levelManager = new LevelManager(this);
-    m_window.setFramerateLimit(60);
+    if (!m_options.replayPath.empty() && m_inputRecorder.startReplay(m_options.replayPath)) {
+        std::cout << "Replay speed: " << m_options.replaySpeed << "x" << std::endl;
+    }
+    else {
+        if (!m_options.recordPath.empty()) {
+            m_inputRecorder.startRecording(m_options.recordPath);
+        }
+    }
+    if (!m_options.headless) {
+        m_window.create(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "GameObject Game");
+        // Replays pace themselves in run()
+        m_window.setFramerateLimit(m_inputRecorder.isReplaying() ? 0 : 60);
+    }
     m_renderSystem = new RenderSystem();
     m_physicsSystem = new PhysicsSystem();
+    m_physicsSystem->setTickRate(m_options.physicsTickRate);
+    m_physicsSystem->setMaxSubsteps(m_options.maxPhysicsSubsteps);
+    // Nothing to overlap the ticks with when there's no window to draw
+    m_physicsSystem->setThreaded(m_options.threadedPhysics && !m_options.headless);
     m_eventSystem = &EventSystem::getInstance();
+    buildPrefabs();
+    registerSystems();
+    // Win and lose are driven by the component counters instead of polling every frame
+    auto& componentManager = ComponentManager::getInstance();
+    m_pigsGoneToken = componentManager.onLastRemoved<PigComponent>([this]() {
+        if (!m_isBuildingScene) {
+            std::cout << "Last pig destroyed" << std::endl;
+            checkLevelCompletion();
+        }
+        });
+    m_birdsGoneToken = componentManager.onLastRemoved<AbilityComponent>([this]() {
+        if (!m_isBuildingScene) {
+            std::cout << "Last bird spent" << std::endl;
+            checkGameOver();
+        }
+        });
+
+    auto& gameplayEvents = GameplayEventQueue::getInstance();
+    m_destroyedSubscription = gameplayEvents.subscribe(GameplayEventType::Destroyed, [](const GameplayEvent& event) {
+        if (auto gameObject = GameObject::find(event.entity)) {
+            gameObject->destroy();
+        }
+        });
+    m_levelCompleteSubscription = gameplayEvents.subscribe(GameplayEventType::LevelComplete, [this](const GameplayEvent& event) {
+        // Ignore it if the level moved on or a pig came back since it was posted
+        if (event.level != m_levelManager->getCurrentLevelIndex() ||
+            ComponentManager::getInstance().count<PigComponent>() != 0 ||
+            m_isGameCompleteScreenActive || m_pendingScene) {
+            return;
+        }
+        if (m_levelManager->isLastLevel()) {
+            showGameCompleteScreen();
+        }
+        else {
+            m_levelManager->nextLevel();
+        }
+        });
+
     initializeLevels();
+    syncStructuralChanges();
 }
 
 Game::~Game() {
+    // Release the last scene before the systems it points into are deleted. Flagged as a
+    // scene build so the win/lose hooks ignore the pigs and birds going away.
+    m_physicsSystem->setThreaded(false);
+    m_isBuildingScene = true;
+    CommandBuffer::getInstance().clearScene();
+    CommandBuffer::getInstance().flush();
+    // The managers outlive this Game, so nothing may call back into it from here on
+    auto& componentManager = ComponentManager::getInstance();
+    componentManager.removeLastRemoved(m_pigsGoneToken);
+    componentManager.removeLastRemoved(m_birdsGoneToken);
+    auto& gameplayEvents = GameplayEventQueue::getInstance();
+    gameplayEvents.unsubscribe(m_destroyedSubscription);
+    gameplayEvents.unsubscribe(m_levelCompleteSubscription);
+
     delete m_levelManager;
     delete m_renderSystem;
     delete m_physicsSystem;
@@ -33,156 +110,103 @@ void Game::run() {
         std::cout << "Error: Physics world not properly initialized" << std::endl;
         return;
     }
-    while (m_window.isOpen()) {
+    sf::Clock replayClock;
+    float replayTime = 0.0f;
+    while (m_isRunning) {
         float deltaTime = clock.restart().asSeconds();
-        
-        handleInput();
-        update(deltaTime);
-        draw();
+
+        if (m_inputRecorder.isReplaying()) {
+            // Recorded delta and events replace the real ones for this frame
+            if (!m_inputRecorder.readFrame(deltaTime, m_frameEvents)) {
+                // A bad recording has already been reported and the replay stopped
+                if (!m_inputRecorder.isReplaying()) {
+                    break;
+                }
+                std::cout << "Replay finished: " << m_inputRecorder.getFrameCount() << " frames in "
+                    << replayClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+                break;
+            }
+        }
+
+        advanceFrame(deltaTime);
+
+        // Pace the replay against the recording, scaled by the replay speed
+        if (m_inputRecorder.isReplaying() && m_options.replaySpeed > 0.0f) {
+            replayTime += deltaTime / m_options.replaySpeed;
+            sf::Time ahead = sf::seconds(replayTime) - replayClock.getElapsedTime();
+            if (ahead > sf::Time::Zero) {
+                sf::sleep(ahead);
+            }
+        }
+    }
+    m_inputRecorder.stop();
+    // Objects are released after run() returns, and their bodies with them
+    m_physicsSystem->setThreaded(false);
+}
+void Game::advanceFrame(float deltaTime) {
+    update(deltaTime);
+    draw();
+}
+void Game::queueEvent(const sf::Event& event) {
+    if (!m_inputRecorder.isReplaying()) {
+        m_queuedEvents.push_back(event);
     }
 }
 void Game::createScene(SceneType scene) {
 
 
     m_currentScene = scene;
-    
-    for (auto& object : GameObject::getAllObjects()) {
-        object->destroy();
-        std::cout << object << std::endl;
-    }
+
+    // Only ever runs at a sync point, so the old scene can be released right away
+    m_isBuildingScene = true;
+    CommandBuffer::getInstance().clearScene();
+    CommandBuffer::getInstance().flush();
+    m_isBuildingScene = false;
+    m_loseTextObject = nullptr;
+    m_retryButtonObject = nullptr;
     m_isLoseScreenActive = false;
     m_isGameCompleteScreenActive = false;
 
-    const std::vector<std::string> spritePaths = {
-        "Sprites/chick",
-        "Sprites/duck",
-        "Sprites/parrot",
-        "Sprites/dannyInRealLife"
-    };
-
-    auto createChick = [&](const sf::Vector2f& position, const std::string& spritePath) {
-        auto bird = GameObject::create(position, "bird");
-        bird->addComponent<TransformComponent>(position.x, position.y);
-        bird->addComponent<SpriteRendererComponent>(spritePath + ".png");
-        bird->addComponent<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f);
-         bird->addComponent<BoxColliderComponent>(1.0f,1.0f);
-         bird->addComponent<DoubleMassAbility>();
-  
-        return  bird;
-        };    
-    auto createDuck = [&](const sf::Vector2f& position, const std::string& spritePath) {
-        auto bird = GameObject::create(position, "bird");
-        bird->addComponent<TransformComponent>(position.x, position.y);
-        bird->addComponent<SpriteRendererComponent>(spritePath + ".png");
-        bird->addComponent<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f);
-         bird->addComponent<BoxColliderComponent>(1.0f,1.0f);
-         bird->addComponent<BoostAbility>();
-  
-        return  bird;
-        };
-    auto createParrot = [&](const sf::Vector2f& position, const std::string& spritePath) {
-        auto bird = GameObject::create(position, "bird");
-        bird->addComponent<TransformComponent>(position.x, position.y);
-        bird->addComponent<SpriteRendererComponent>(spritePath + ".png");
-        bird->addComponent<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f);
-        bird->addComponent<BoxColliderComponent>(1.0f, 1.0f);
-        bird->addComponent<SplitAbility>();
-
-        return  bird;
-        };
-    auto createPig= [&](const sf::Vector2f& position, const std::string& spritePath  = "Sprites/dannyInRealLife") {
-
-        auto pig = GameObject::create(position, "pig");
-
-        auto transform = pig->addComponent<TransformComponent>(position.x, position.y);
-        transform->setScale(1.0f, 1.0f);
-
-        pig->addComponent<SpriteRendererComponent>(spritePath + ".png");
-
-        pig->addComponent<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f);
-
-        pig->addComponent<CircleColliderComponent>(1.0f, sf::Vector2f(30, 35));
-
-        pig->addComponent<BreakableComponent>(30);
-
-        pig->addComponent<PigComponent>();
-        std::cout << "Pig creation completed" << std::endl;
-        return pig;
-        };
-    auto createPlatform = [&](const sf::Vector2f& position, const sf::Vector2f& size = sf::Vector2f(1,1)) {
-        auto plat = GameObject::create(position, "platform");
-        plat->addComponent<TransformComponent>(position.x, position.y);
-        plat->getComponent<TransformComponent>()->setScale(size.x, size.y);
-        plat->addComponent<SpriteRendererComponent>("Sprites/ground.png");
-
-        plat->addComponent<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f);
-        plat->addComponent<BoxColliderComponent>(size.x, size.y);
-        plat->addComponent<BreakableComponent>(30);
-        return plat;
-        };
-
-    auto createLauncher = [&](const float x, const float y, const std::function<GameObject* (const sf::Vector2f&, const std::string&)>& birdCreator, const std::string& spritePath) {
+    auto createLauncher = [&](const float x, const float y, const Prefab& birdPrefab) {
+        auto birdCreator = [&birdPrefab](const sf::Vector2f& position, const std::string&) {
+            return birdPrefab.instantiate(position);
+            };
         auto position = sf::Vector2f(x, y);
         auto launcher = GameObject::create(position, "launcher");
         launcher->addComponent<TransformComponent>(x, y);
         launcher->addComponent<RenderComponent>(sf::Color::Red);
-        launcher->addComponent<BirdLauncherComponent>(&m_window, GetPhysicsWorld(), position, birdCreator, spritePath);
+        launcher->addComponent<BirdLauncherComponent>(&m_window, GetPhysicsWorld(), position, birdCreator, birdPrefab.getName());
         };
 
     switch (scene) {
     case SceneType::MAIN_MENU:
     {
-      
-     
-  
-       auto danny =  createPig(sf::Vector2f(550, 350));
-   
+        m_pigPrefab->instantiate(sf::Vector2f(550, 350));
     }
     break;
     case SceneType::LEVEL_1:
     {
-      
-        createLauncher(200, 450, createChick, spritePaths[0]);
-
-        createPlatform(sf::Vector2f(400, 550));
-        createPlatform(sf::Vector2f(400, 475));
-        createPlatform(sf::Vector2f(400, 425)); 
-        
-  
-
-
-
-        
-
-        createPig(sf::Vector2f(633, 500));
-   
+        createLauncher(200, 450, *m_chickPrefab);
+        m_platformPrefab->spawnBatch(std::vector<sf::Vector2f>{ { 400, 550 }, { 400, 475 }, { 400, 425 } });
+        m_pigPrefab->instantiate(sf::Vector2f(633, 500));
     }
     break;
     case SceneType::LEVEL_2:
     {
-        createLauncher(200, 500, createDuck, spritePaths[1]);
-        createPig(sf::Vector2f(700, 375));
-        createPlatform(sf::Vector2f(700, 550));
-        createPlatform(sf::Vector2f(700, 475));
-        createPlatform(sf::Vector2f(700, 425));
+        createLauncher(200, 500, *m_duckPrefab);
+        m_pigPrefab->instantiate(sf::Vector2f(700, 375));
+        m_platformPrefab->spawnBatch(std::vector<sf::Vector2f>{ { 700, 550 }, { 700, 475 }, { 700, 425 } });
     }
     break;
     case SceneType::BOSS_FIGHT:
     {
-        createLauncher(200, 500, createParrot, spritePaths[2]);
-        createPig(sf::Vector2f(550, 375));
-        createPlatform(sf::Vector2f(550, 550));
-        createPlatform(sf::Vector2f(550, 475));
-        createPlatform(sf::Vector2f(550, 425));
-
-        createPig(sf::Vector2f(625, 550));
-        createPig(sf::Vector2f(700, 375));
-        createPlatform(sf::Vector2f(700, 550));
-        createPlatform(sf::Vector2f(700, 475));
-        createPlatform(sf::Vector2f(700, 425));
+        createLauncher(200, 500, *m_parrotPrefab);
+        m_pigPrefab->spawnBatch(std::vector<sf::Vector2f>{ { 550, 375 }, { 625, 550 }, { 700, 375 } });
+        m_platformPrefab->spawnBatch(std::vector<sf::Vector2f>{ { 550, 550 }, { 550, 475 }, { 550, 425 }, { 700, 550 }, { 700, 475 }, { 700, 425 } });
     }
     break;
     }
+    CommandBuffer::getInstance().flush();
     for (size_t i = 0; i < GameObject::getAllObjects().size(); ++i) {
         auto& gameObject = GameObject::getAllObjects()[i];
         if (gameObject == nullptr) {
@@ -200,56 +224,169 @@ void Game::createScene(SceneType scene) {
             std::cout << "Unknown exception caught while starting object at index " << i << std::endl;
         }
     }
+    // Pick up anything spawned from start(), like the launcher's first bird
+    CommandBuffer::getInstance().flush();
+    m_levelSnapshot.capture();
 
 
 }
 
 
-void Game::update(float deltaTime) {
-    if (m_isLoseScreenActive) {
-        // Update only lose screen objects
-        if (m_loseTextObject) {
-            m_loseTextObject->update(deltaTime);
+void Game::requestScene(SceneType scene) {
+    m_pendingScene = scene;
+}
+
+void Game::syncStructuralChanges() {
+    // Gameplay reactions first, so anything they destroy or spawn is applied by this flush
+    GameplayEventQueue::getInstance().dispatch();
+    CommandBuffer::getInstance().flush();
+    if (m_pendingScene) {
+        SceneType scene = *m_pendingScene;
+        m_pendingScene.reset();
+        m_isRetryPending = false;
+        createScene(scene);
+    }
+    else if (m_isRetryPending) {
+        m_isRetryPending = false;
+        sf::Clock retryClock;
+        if (m_levelSnapshot.restore()) {
+            CommandBuffer::getInstance().flush();
+            std::cout << "Level restored in " << retryClock.getElapsedTime().asMicroseconds() / 1000.0f << " ms" << std::endl;
         }
-        if (m_retryButtonObject) {
-            m_retryButtonObject->update(deltaTime);
+        else {
+            m_levelManager->retryCurrentLevel();
         }
     }
-    else {
-        // Normal game update
-        m_physicsSystem->update(deltaTime);
-
-        checkGameOver();
+}
 
-        auto& objects = GameObject::getAllObjects();
-        for (auto& gameObject : objects) {
-            gameObject->update(deltaTime);
-        }
+void Game::buildPrefabs() {
+    TextureCache::getInstance().preload({
+        "Sprites/chick.png",
+        "Sprites/duck.png",
+        "Sprites/parrot.png",
+        "Sprites/dannyInRealLife.png",
+        "Sprites/ground.png"
+        });
+
+    auto makeBird = [&](const std::string& spritePath) {
+        auto bird = std::make_unique<Prefab>("bird");
+        bird->add<SpriteRendererComponent>(spritePath)
+            .add<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f)
+            .add<BoxColliderComponent>(1.0f, 1.0f);
+        return bird;
+        };
+    m_chickPrefab = makeBird("Sprites/chick.png");
+    m_chickPrefab->add<DoubleMassAbility>();
+    m_duckPrefab = makeBird("Sprites/duck.png");
+    m_duckPrefab->add<BoostAbility>();
+    m_parrotPrefab = makeBird("Sprites/parrot.png");
+    m_parrotPrefab->add<SplitAbility>();
+
+    m_pigPrefab = std::make_unique<Prefab>("pig");
+    m_pigPrefab->withScale(sf::Vector2f(1.0f, 1.0f))
+        .add<SpriteRendererComponent>("Sprites/dannyInRealLife.png")
+        .add<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f)
+        .add<CircleColliderComponent>(1.0f, sf::Vector2f(30, 35))
+        .add<BreakableComponent>(30)
+        .add<PigComponent>();
+
+    m_platformPrefab = std::make_unique<Prefab>("platform");
+    m_platformPrefab->withScale(sf::Vector2f(1.0f, 1.0f))
+        .add<SpriteRendererComponent>("Sprites/ground.png")
+        .add<RigidBodyComponent>(GetPhysicsWorld(), 1.0f, 1.0f)
+        .add<BoxColliderComponent>(1.0f, 1.0f)
+        .add<BreakableComponent>(30);
+}
 
-        objects.erase(std::remove_if(objects.begin(), objects.end(), [](GameObject* obj) {
-            if (obj->isDestroyed()) {
-                ComponentManager::getInstance().removeComponents(obj);
-                delete obj;
-                return true;
+void Game::registerSystems() {
+    auto& componentManager = ComponentManager::getInstance();
+    // Everything the event handlers move or launch, plus the handlers themselves
+    const ComponentSignature inputWrites = componentManager.signatureOf<TransformComponent, RigidBodyComponent,
+        FollowMouseComponent, BirdLauncherComponent, AbilityComponent, ButtonComponent>();
+    const ComponentSignature colliders = componentManager.signatureOf<CircleColliderComponent, BoxColliderComponent>();
+    // Stepping moves bodies, and the contacts resolved after each step deal damage
+    const ComponentSignature physicsWrites = componentManager.signatureOf<TransformComponent, RigidBodyComponent,
+        BreakableComponent>();
+    // Components that override update(), and what those updates move
+    const ComponentSignature updateWrites = componentManager.signatureOf<TransformComponent, RigidBodyComponent,
+        RenderComponent, FollowMouseComponent, BirdLauncherComponent, TextRendererComponent, ButtonComponent>();
+
+    m_scheduler.addSystem({ "Input", SystemPhase::Input, componentManager.signatureOf<TransformComponent>(), inputWrites, true,
+        [this](float deltaTime) { handleInput(deltaTime); } });
+
+    m_scheduler.addSystem({ "Bird drift", SystemPhase::PrePhysics,
+        {}, componentManager.signatureOf<TransformComponent>(), true,
+        [this](float deltaTime) {
+            if (m_isLoseScreenActive || !m_bird) {
+                return;
             }
-            return false;
-            }), objects.end());
-
-        if (m_bird) {
             auto transform = m_bird->getComponent<TransformComponent>();
             if (transform) {
-                transform->position.x += 1.0f * deltaTime;
+                transform->setPosition(transform->getPosition().x + 1.0f * deltaTime, transform->getPosition().y);
             }
-        }
+        } });
 
-        if (!m_isLoseScreenActive && !m_isGameCompleteScreenActive) {
-            checkLevelCompletion();
-        }
-    }
+    m_scheduler.addSystem({ "Physics", SystemPhase::Physics, colliders, physicsWrites, true,
+        [this](float deltaTime) {
+            if (!m_isLoseScreenActive) {
+                m_physicsSystem->update(deltaTime);
+            }
+        } });
+
+    // Bodies are created lazily from the colliders on the first update
+    m_scheduler.addSystem({ "Object update", SystemPhase::PostPhysics, colliders, updateWrites, true,
+        [this](float deltaTime) {
+            if (m_isLoseScreenActive) {
+                // Update only lose screen objects
+                if (m_loseTextObject) {
+                    m_loseTextObject->update(deltaTime);
+                }
+                if (m_retryButtonObject) {
+                    m_retryButtonObject->update(deltaTime);
+                }
+                return;
+            }
+            for (auto& gameObject : GameObject::getAllObjects()) {
+                gameObject->update(deltaTime);
+            }
+        } });
+
+    m_scheduler.addSystem({ "Shape prep", SystemPhase::RenderPrep,
+        componentManager.signatureOf<TransformComponent>(), componentManager.signatureOf<RenderComponent>(), false,
+        [this](float) { m_renderSystem->prepareShapes(); } });
+    m_scheduler.addSystem({ "Sprite prep", SystemPhase::RenderPrep,
+        componentManager.signatureOf<TransformComponent>(), componentManager.signatureOf<SpriteRendererComponent>(), false,
+        [this](float) { m_renderSystem->prepareSprites(); } });
+    // Render-prep runs on workers, so its queries must exist before the first frame
+    componentManager.view<TransformComponent, RenderComponent>();
+    componentManager.view<TransformComponent, SpriteRendererComponent>();
+}
 
+void Game::update(float deltaTime) {
+    // With threaded physics, take the world back from the ticks launched last frame
+    m_physicsSystem->waitForStep();
+    m_scheduler.run(deltaTime, SystemPhase::Input, SystemPhase::PostPhysics);
+
+    // Sync point: objects created, destroyed or scenes requested during the frame are applied here.
+    // Win and lose checks run from here too, through the last-removed hooks set up in the constructor.
+    syncStructuralChanges();
 }
 
 void Game::draw() {
+    if (!m_window.isOpen()) {
+        // Headless replay
+        return;
+    }
+
+    // After the sync point, so objects spawned this frame are placed before they're drawn
+    auto& transformStorage = TransformStorage::getInstance();
+    transformStorage.publishDrawPoses(m_physicsSystem->getInterpolationAlpha());
+    m_scheduler.run(0.0f, SystemPhase::RenderPrep, SystemPhase::RenderPrep);
+    transformStorage.clearRenderDirty();
+
+    // Everything below reads the draw pose, so the next ticks can run alongside it
+    m_physicsSystem->launchStep();
+
     m_window.clear();
 
     if (m_isLoseScreenActive) {
@@ -263,31 +400,60 @@ void Game::draw() {
 
     m_window.display();
 }
-void Game::handleInput() {
+void Game::handleInput(float deltaTime) {
     sf::Event event;
-    while (m_window.pollEvent(event)) {
+    if (m_inputRecorder.isReplaying()) {
+        // This frame's events were read from the recording in run(). The window is still
+        // pumped so it stays responsive and can be closed.
+        while (m_window.isOpen() && m_window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                m_isRunning = false;
+                m_window.close();
+            }
+        }
+    }
+    else {
+        m_frameEvents.clear();
+        while (m_window.pollEvent(event)) {
+            m_frameEvents.push_back(event);
+        }
+        m_frameEvents.insert(m_frameEvents.end(), m_queuedEvents.begin(), m_queuedEvents.end());
+        m_queuedEvents.clear();
+        m_inputRecorder.writeFrame(deltaTime, m_frameEvents);
+    }
+
+    for (const auto& frameEvent : m_frameEvents) {
+        processEvent(frameEvent);
+    }
+}
 
-        m_eventSystem->dispatchEvent(event);
+void Game::processEvent(const sf::Event& event) {
+    m_eventSystem->dispatchEvent(event);
 
-        if (event.type == sf::Event::Closed) {
+    if (event.type == sf::Event::Closed) {
+        m_isRunning = false;
+        if (m_window.isOpen()) {
             m_window.close();
         }
+    }
 
-        if (event.type == sf::Event::KeyPressed) {
-            switch (event.key.code) {
-            case sf::Keyboard::Num1:
-                createScene(SceneType::MAIN_MENU);
-                break;
-            case sf::Keyboard::Num2:
-                createScene(SceneType::LEVEL_1);
-                break;
-            case sf::Keyboard::Num3:
-                createScene(SceneType::LEVEL_2);
-                break;
-            case sf::Keyboard::Num4:
-                createScene(SceneType::BOSS_FIGHT);
-                break;
-            }
+    if (event.type == sf::Event::KeyPressed) {
+        switch (event.key.code) {
+        case sf::Keyboard::Num1:
+            requestScene(SceneType::MAIN_MENU);
+            break;
+        case sf::Keyboard::Num2:
+            requestScene(SceneType::LEVEL_1);
+            break;
+        case sf::Keyboard::Num3:
+            requestScene(SceneType::LEVEL_2);
+            break;
+        case sf::Keyboard::Num4:
+            requestScene(SceneType::BOSS_FIGHT);
+            break;
+        case sf::Keyboard::F3:
+            m_scheduler.printTimings();
+            break;
         }
     }
 }
@@ -301,24 +467,19 @@ void Game::showGameCompleteScreen() {
 
 void Game::retryLevel() {
     destroyLoseScreen();
-    m_levelManager->retryCurrentLevel();
+    // Restored at the sync point from the level-start snapshot, falls back to a rebuild
+    m_isRetryPending = true;
 }
 
 void Game::checkLevelCompletion() {
-    int pigCount = 0;
-    for (auto& object : GameObject::getAllObjects()) {
-        if (object->getComponent<PigComponent>()) {
-            pigCount++;
-        }
+    if (m_isLoseScreenActive || m_isGameCompleteScreenActive) {
+        return;
     }
 
-    if (pigCount == 0) {
-        if (m_levelManager->isLastLevel()) {
-            showGameCompleteScreen();
-        }
-        else {
-            m_levelManager->nextLevel();
-        }
+    if (ComponentManager::getInstance().count<PigComponent>() == 0) {
+        GameplayEvent levelComplete{ GameplayEventType::LevelComplete };
+        levelComplete.level = m_levelManager->getCurrentLevelIndex();
+        GameplayEventQueue::getInstance().post(levelComplete);
     }
 }
 
@@ -374,9 +535,10 @@ void Game::destroyLoseScreen() {
 }
 void Game::createGameCompleteScreen() {
     // Clear existing objects
-    for (auto& object : GameObject::getAllObjects()) {
-        object->destroy();
-    }
+    CommandBuffer::getInstance().clearScene();
+    m_levelSnapshot.clear();
+    m_loseTextObject = nullptr;
+    m_retryButtonObject = nullptr;
 
     // Create "Game Complete" text
     auto completeText = GameObject::create(sf::Vector2f(600, 1000), "completeText");
@@ -385,14 +547,12 @@ void Game::createGameCompleteScreen() {
     textRenderer->setFillColor(sf::Color::Green);
 }
 void Game::checkGameOver() {
-    bool hasBirds = false;
-    bool hasLauncher = false;
-    for (auto& object : GameObject::getAllObjects()) {
-        if (object->getComponent<AbilityComponent>()) {
-            hasBirds = true;
-        }
+    if (m_isLoseScreenActive || m_isGameCompleteScreenActive) {
+        return;
     }
 
+    bool hasBirds = ComponentManager::getInstance().count<AbilityComponent>() > 0;
+
   
     if (!hasBirds) {
         showLoseScreen();
@@ -3,6 +3,14 @@
 #include <SFML/Graphics.hpp>
 #include "GameObject.h"
 #include "LevelManager.h"
+#include "SystemScheduler.h"
+#include "Prefab.h"
+#include "LevelSnapshot.h"
+#include "InputRecorder.h"
+#include "GameplayEvents.h"
+#include <string>
+#include <memory>
+#include <optional>
 
 enum class SceneType {
     MAIN_MENU,
@@ -17,11 +25,31 @@ class RenderSystem;
 class PhysicsSystem;
 class EventSystem;
 
+// Set from the command line in main.cpp
+struct GameOptions {
+    std::string recordPath;
+    std::string replayPath;
+    // Replay speed relative to the recording, 0 runs as fast as possible
+    float replaySpeed = 1.0f;
+    // Run without opening a window, input then only comes from a replay
+    bool headless = false;
+    // Physics runs in fixed ticks at this rate, whatever the frame rate
+    float physicsTickRate = 60.0f;
+    int maxPhysicsSubsteps = 5;
+    // Step Box2D on its own thread while the frame is drawn
+    bool threadedPhysics = false;
+};
+
 class Game {
 public:
-    Game();
+    Game(const GameOptions& options = GameOptions());
     ~Game();
     void run();
+    // One frame of run(): update, the sync point, then draw. Without a window only the update runs.
+    void advanceFrame(float deltaTime);
+    // Feeds an event to the next frame as if the window had produced it, and records it
+    // like real input. Ignored while replaying, the recording drives input then.
+    void queueEvent(const sf::Event& event);
     Box2DWorld* GetPhysicsWorld() {
         if (m_physicsSystem == nullptr || m_physicsSystem->GetWorld() == nullptr) {
             std::cout << "Error: Physics world is null" << std::endl;
@@ -37,25 +65,55 @@ public:
     void initializeLevels();
     LevelManager& getLevelManager() { return *m_levelManager; }
     void createScene(SceneType scene);
+    // Safe to call mid-frame, the scene is built at the next sync point
+    void requestScene(SceneType scene);
 
 private:
     void update(float deltaTime);
     void draw();
-    void handleInput();
+    void handleInput(float deltaTime);
+    void processEvent(const sf::Event& event);
+    void buildPrefabs();
+    void registerSystems();
+    void syncStructuralChanges();
     void checkGameOver();
     void createLoseScreen();
     void destroyLoseScreen();
     void createGameCompleteScreen();
 
+    GameOptions m_options;
+    bool m_isRunning;
+    InputRecorder m_inputRecorder;
+    // This frame's input, polled from the window or read from a replay
+    std::vector<sf::Event> m_frameEvents;
+    // From queueEvent, appended after the window's own events
+    std::vector<sf::Event> m_queuedEvents;
+
     bool m_isLoseScreenActive;
     bool m_isGameCompleteScreenActive;
+    // Set while the old scene is torn down so its pigs and birds don't count as won or lost
+    bool m_isBuildingScene;
+    bool m_isRetryPending;
 
     LevelManager* m_levelManager;
     sf::RenderWindow m_window;
     SceneType m_currentScene;
+    std::optional<SceneType> m_pendingScene;
+    LevelSnapshot m_levelSnapshot;
     RenderSystem* m_renderSystem;
     PhysicsSystem* m_physicsSystem;
     EventSystem* m_eventSystem;
+    SystemScheduler m_scheduler;
+    // Win and lose hooks on the ComponentManager, removed again by ~Game
+    ComponentManager::CallbackToken m_pigsGoneToken;
+    ComponentManager::CallbackToken m_birdsGoneToken;
+    GameplayEventQueue::SubscriptionToken m_destroyedSubscription;
+    GameplayEventQueue::SubscriptionToken m_levelCompleteSubscription;
+    std::unique_ptr<Prefab> m_chickPrefab;
+    std::unique_ptr<Prefab> m_duckPrefab;
+    std::unique_ptr<Prefab> m_parrotPrefab;
+    std::unique_ptr<Prefab> m_pigPrefab;
+    std::unique_ptr<Prefab> m_platformPrefab;
     GameObject* m_bird;
 
  
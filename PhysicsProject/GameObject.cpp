@@ -1,23 +1,36 @@
 #include "GameObject.h"
+#include "EntityManager.h"
+#include "ObjectPool.h"
+#include "CommandBuffer.h"
 
 
 
 std::vector<GameObject*> GameObject::s_allObjects;
 
+static ObjectPool<GameObject>& objectPool() {
+    // Objects unregister their entity on destruction, so the entity manager has to outlive the pool
+    EntityManager::getInstance();
+    static ObjectPool<GameObject> pool;
+    return pool;
+}
+
 GameObject* GameObject::create(const sf::Vector2f& position, std::string name) {
-    auto obj = new GameObject(position);
+    auto obj = objectPool().create(position);
     obj->m_name = name;
+    obj->m_entity = EntityManager::getInstance().create(obj);
     if (obj->m_name.empty()) {
         std::cout << "Warning: Empty name provided for GameObject" << std::endl;
         obj->m_name = "Unnamed Object";
     }
-    s_allObjects.push_back(obj);
-    std::cout << "Created GameObject: " << obj->getName() << ", Total objects: " << s_allObjects.size() << std::endl;
+    // Joins s_allObjects at the next CommandBuffer flush, never in the middle of an update
+    CommandBuffer::getInstance().recordCreate(obj);
+    std::cout << "Created GameObject: " << obj->getName() << std::endl;
     return obj;
 }
 GameObject::~GameObject() {
     try {
         std::cout << "Destroying GameObject: " << m_name << std::endl;
+        EntityManager::getInstance().destroy(m_entity);
         // Clean up any resources, if necessary
     }
     catch (const std::exception& e) {
@@ -58,18 +71,15 @@ void GameObject::start() {
 
 
 void GameObject::update(float deltaTime) {
-    for (auto& component : ComponentManager::getInstance().getAllComponents(this)) {
+    for (auto& component : ComponentManager::getInstance().getUpdatables(this)) {
         component->update(deltaTime);
     }
 }
 
 void GameObject::OnCollision(GameObject* other)
 {
-    for (auto& component : ComponentManager::getInstance().getAllComponents(this)) {
-        auto* collider = dynamic_cast<ICollider*>(component);
-        if (!collider) {
-            component->onCollision(other);    
-        }
+    for (auto& component : ComponentManager::getInstance().getCollisionHandlers(this)) {
+        component->onCollision(other);
     }
 }
 
@@ -80,8 +90,32 @@ std::vector<GameObject*>& GameObject::getAllObjects() {
     return s_allObjects;
 }
 
+void GameObject::release(GameObject* object) {
+    objectPool().release(object);
+}
+
+void GameObject::releaseAll() {
+    // Components go first, while the singletons and the physics world they reference are
+    // still alive. Objects whose components were already removed are skipped.
+    auto& componentManager = ComponentManager::getInstance();
+    objectPool().forEach([&componentManager](GameObject& object) {
+        if (!componentManager.getAllComponents(&object).empty()) {
+            componentManager.removeComponents(&object);
+        }
+        });
+    objectPool().releaseAll();
+    s_allObjects.clear();
+}
+
+GameObject* GameObject::find(Entity entity) {
+    return EntityManager::getInstance().getObject(entity);
+}
+
 void GameObject::destroy() {
-    m_isDestroyed = true;
+    if (!m_isDestroyed) {
+        m_isDestroyed = true;
+        CommandBuffer::getInstance().recordDestroy();
+    }
 }
 
 bool GameObject::isDestroyed() const {
@@ -3,14 +3,21 @@
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include "Entity.h"
 
 // Forward declarations
 class Component;
 class ComponentManager;
+class Prefab;
 
 class GameObject {
 public:
     static GameObject* create(const sf::Vector2f& position, std::string name);
+    // Returns an object to the pool. Its components must already have been removed.
+    static void release(GameObject* object);
+    // Removes every object's components and releases all objects at once, used when a
+    // whole scene is thrown away
+    static void releaseAll();
 
     void setPosition(const sf::Vector2f& position);
     const sf::Vector2f& getPosition() const;
@@ -21,12 +28,21 @@ public:
     template<typename T>
     T* getComponent();
 
+    template<typename T>
+    bool hasComponent();
+
     virtual void start();
     virtual void update(float deltaTime);
     virtual void OnCollision(GameObject* other);
     virtual void draw(sf::RenderWindow& window);
 
     static std::vector<GameObject*>& getAllObjects();
+    // Resolves a handle, returns nullptr if the object has since been deleted
+    static GameObject* find(Entity entity);
+    Entity getEntity() const { return m_entity; }
+    // The prefab this object was spawned from, nullptr if it was built by hand
+    const Prefab* getPrefab() const { return m_prefab; }
+    void setPrefab(const Prefab* prefab) { m_prefab = prefab; }
 
     void destroy();
     bool isDestroyed() const;
@@ -38,6 +54,8 @@ private:
 
     sf::Vector2f m_position;
     bool m_isDestroyed;
+    Entity m_entity;
+    const Prefab* m_prefab = nullptr;
     static std::vector<GameObject*> s_allObjects;
 };
 
@@ -12,4 +12,9 @@ T* GameObject::getComponent() {
     return ComponentManager::getInstance().getComponent<T>(this);
 }
 
+template<typename T>
+bool GameObject::hasComponent() {
+    return ComponentManager::getInstance().hasComponent<T>(this);
+}
+
 
@@ -0,0 +1,56 @@
+#include "GameplayEvents.h"
+#include <iostream>
+
+GameplayEventQueue& GameplayEventQueue::getInstance() {
+    static GameplayEventQueue instance;
+    return instance;
+}
+
+GameplayEventQueue::GameplayEventQueue() {
+    m_batch.reserve(Capacity);
+}
+
+void GameplayEventQueue::post(GameplayEventType type, Entity entity, Entity other, float amount) {
+    post(GameplayEvent{ type, entity, other, amount });
+}
+
+void GameplayEventQueue::post(const GameplayEvent& event) {
+    if (!m_ring.push(event)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+GameplayEventQueue::SubscriptionToken GameplayEventQueue::subscribe(GameplayEventType type, Handler handler) {
+    const std::uint32_t id = m_nextSubscriptionId++;
+    m_handlers[static_cast<std::size_t>(type)].push_back({ id, std::move(handler) });
+    return { type, id };
+}
+
+void GameplayEventQueue::unsubscribe(SubscriptionToken token) {
+    if (token.type == GameplayEventType::Count) {
+        return;
+    }
+    std::erase_if(m_handlers[static_cast<std::size_t>(token.type)], [&token](const Subscription& subscription) {
+        return subscription.id == token.id;
+        });
+}
+
+void GameplayEventQueue::dispatch() {
+    // Take the batch first so handlers that post don't keep this loop going
+    m_batch.clear();
+    GameplayEvent event;
+    while (m_batch.size() < Capacity && m_ring.pop(event)) {
+        m_batch.push_back(event);
+    }
+
+    for (const auto& queued : m_batch) {
+        for (const auto& subscription : m_handlers[static_cast<std::size_t>(queued.type)]) {
+            subscription.handler(queued);
+        }
+    }
+
+    const std::size_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        std::cout << "Warning: gameplay event queue full, dropped " << dropped << " events" << std::endl;
+    }
+}
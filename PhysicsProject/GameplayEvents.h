@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "Entity.h"
+#include "MpscRing.h"
+
+enum class GameplayEventType : std::uint8_t {
+    Damage,        // entity took amount damage from other
+    Destroyed,     // entity ran out of health, other dealt the final hit
+    Launched,      // entity (a bird) left the sling
+    AbilityFired,  // entity's ability was triggered
+    LevelComplete, // level holds the finished level index
+    Count
+};
+
+// Plain data so events can be copied through the ring without allocating
+struct GameplayEvent {
+    GameplayEventType type;
+    Entity entity;
+    Entity other;
+    float amount = 0.0f;
+    std::int32_t level = 0;
+};
+
+// Gameplay reactions are posted here instead of running inline, from any thread or system,
+// and dispatched in one batch at the frame's sync point before structural changes apply.
+class GameplayEventQueue {
+public:
+    using Handler = std::function<void(const GameplayEvent&)>;
+
+    static GameplayEventQueue& getInstance();
+
+    // Lock-free, callable from any thread. If the ring is full the event is dropped and
+    // counted, the count is reported at the next dispatch.
+    void post(GameplayEventType type, Entity entity = Entity{}, Entity other = Entity{}, float amount = 0.0f);
+    void post(const GameplayEvent& event);
+
+    struct SubscriptionToken {
+        GameplayEventType type = GameplayEventType::Count;
+        std::uint32_t id = 0;
+    };
+    // Main thread only, and not from inside a handler. Whoever subscribes keeps the token
+    // and unsubscribes before the handler's captures go away; the queue outlives them all.
+    SubscriptionToken subscribe(GameplayEventType type, Handler handler);
+    void unsubscribe(SubscriptionToken token);
+    // Drains what was queued when it started and calls the subscribers. Events posted by
+    // the handlers wait for the next dispatch.
+    void dispatch();
+
+private:
+    GameplayEventQueue();
+    GameplayEventQueue(const GameplayEventQueue&) = delete;
+    GameplayEventQueue& operator=(const GameplayEventQueue&) = delete;
+
+    static constexpr std::size_t Capacity = 1024;
+
+    MpscRing<GameplayEvent, Capacity> m_ring;
+    std::vector<GameplayEvent> m_batch;
+    struct Subscription {
+        std::uint32_t id;
+        Handler handler;
+    };
+
+    std::vector<Subscription> m_handlers[static_cast<std::size_t>(GameplayEventType::Count)];
+    std::uint32_t m_nextSubscriptionId = 1;
+    std::atomic<std::size_t> m_dropped{ 0 };
+};
@@ -0,0 +1,112 @@
+#include "InputRecorder.h"
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<sf::Event>, "sf::Event is written to disk byte for byte");
+
+bool InputRecorder::startRecording(const std::string& path) {
+    stop();
+    m_file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        std::cout << "Error: could not open " << path << " for recording" << std::endl;
+        return false;
+    }
+    m_file.write(Magic, sizeof(Magic));
+    m_mode = Mode::Recording;
+    std::cout << "Recording input to " << path << std::endl;
+    return true;
+}
+
+bool InputRecorder::startReplay(const std::string& path) {
+    stop();
+    m_file.open(path, std::ios::in | std::ios::binary);
+    if (!m_file) {
+        std::cout << "Error: could not open " << path << " for replay" << std::endl;
+        return false;
+    }
+    char magic[sizeof(Magic)] = {};
+    m_file.read(magic, sizeof(magic));
+    if (!m_file || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+        std::cout << "Error: " << path << " is not an input recording" << std::endl;
+        m_file.close();
+        return false;
+    }
+    m_mode = Mode::Replaying;
+    std::cout << "Replaying input from " << path << std::endl;
+    return true;
+}
+
+void InputRecorder::stop() {
+    if (m_mode == Mode::Recording) {
+        std::cout << "Recorded " << m_frameCount << " frames" << std::endl;
+    }
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_mode = Mode::Off;
+    m_frameCount = 0;
+}
+
+void InputRecorder::writeFrame(float deltaTime, const std::vector<sf::Event>& events) {
+    if (m_mode != Mode::Recording) {
+        return;
+    }
+    const std::uint32_t count = static_cast<std::uint32_t>(events.size());
+    m_file.write(reinterpret_cast<const char*>(&deltaTime), sizeof(deltaTime));
+    m_file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (count > 0) {
+        m_file.write(reinterpret_cast<const char*>(events.data()), sizeof(sf::Event) * count);
+    }
+    ++m_frameCount;
+}
+
+bool InputRecorder::readFrame(float& deltaTime, std::vector<sf::Event>& events) {
+    if (m_mode != Mode::Replaying) {
+        return false;
+    }
+    std::uint32_t count = 0;
+    m_file.read(reinterpret_cast<char*>(&deltaTime), sizeof(deltaTime));
+    if (m_file.gcount() == 0 && m_file.eof()) {
+        // Clean end of the recording, on a frame boundary
+        return false;
+    }
+    if (!m_file) {
+        return failReplay("input recording ends mid-frame");
+    }
+    m_file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!m_file) {
+        return failReplay("input recording ends mid-frame");
+    }
+    if (!std::isfinite(deltaTime) || deltaTime < 0.0f || deltaTime > MaxFrameTime) {
+        return failReplay("input recording has an invalid frame time");
+    }
+    if (count > MaxEventsPerFrame) {
+        return failReplay("input recording has an invalid event count");
+    }
+
+    events.resize(count);
+    if (count > 0) {
+        m_file.read(reinterpret_cast<char*>(events.data()), sizeof(sf::Event) * count);
+        if (!m_file) {
+            events.clear();
+            return failReplay("input recording ends mid-frame");
+        }
+        for (const sf::Event& event : events) {
+            if (event.type < 0 || event.type >= sf::Event::Count) {
+                events.clear();
+                return failReplay("input recording has an invalid event");
+            }
+        }
+    }
+    ++m_frameCount;
+    return true;
+}
+
+bool InputRecorder::failReplay(const char* reason) {
+    std::cout << "Error: " << reason << " at frame " << m_frameCount << ", replay stopped" << std::endl;
+    m_file.close();
+    m_mode = Mode::Off;
+    return false;
+}
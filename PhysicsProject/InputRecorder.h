@@ -0,0 +1,48 @@
+#pragma once
+#include <SFML/Window/Event.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Records the frame delta and every sf::Event of each frame to a binary file, and plays
+// such a file back. Every input the game reacts to arrives as an sf::Event, so replaying
+// the stream with the recorded deltas reproduces a session frame for frame.
+//
+// File layout: "AIR1", then per frame a float delta, a uint32 event count and that many
+// raw sf::Event structs. Events are stored as-is, so files only replay on the same build.
+class InputRecorder {
+public:
+    bool startRecording(const std::string& path);
+    bool startReplay(const std::string& path);
+    void stop();
+
+    bool isRecording() const { return m_mode == Mode::Recording; }
+    bool isReplaying() const { return m_mode == Mode::Replaying; }
+
+    void writeFrame(float deltaTime, const std::vector<sf::Event>& events);
+    // Fills the next recorded frame. Returns false once the file is exhausted. A truncated
+    // or corrupt frame also returns false, after logging it and stopping the replay.
+    bool readFrame(float& deltaTime, std::vector<sf::Event>& events);
+
+    std::uint32_t getFrameCount() const { return m_frameCount; }
+
+private:
+    enum class Mode {
+        Off,
+        Recording,
+        Replaying
+    };
+
+    static constexpr char Magic[4] = { 'A', 'I', 'R', '1' };
+    // Far more than a frame of real input, anything above is a corrupt count
+    static constexpr std::uint32_t MaxEventsPerFrame = 1024;
+    // A longer frame than this isn't something the game ever records
+    static constexpr float MaxFrameTime = 60.0f;
+
+    bool failReplay(const char* reason);
+
+    Mode m_mode = Mode::Off;
+    std::fstream m_file;
+    std::uint32_t m_frameCount = 0;
+};
@@ -0,0 +1,178 @@
+#include "JobSystem.h"
+#include <iostream>
+
+namespace {
+    // Which deque the current thread owns. The main thread and any other outside thread use 0.
+    thread_local std::size_t t_queueIndex = 0;
+}
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance(defaultWorkerCount());
+    return instance;
+}
+
+std::size_t JobSystem::defaultWorkerCount() {
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+JobSystem::JobSystem(std::size_t workers) {
+    m_queues.reserve(workers + 1);
+    for (std::size_t i = 0; i < workers + 1; ++i) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    m_workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+    std::cout << "Job system started with " << workers << " worker threads" << std::endl;
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+JobHandle JobSystem::schedule(std::function<void()> work, const std::vector<JobHandle>& dependencies) {
+    auto job = std::make_shared<Job>();
+    job->work = std::move(work);
+
+    for (const auto& dependency : dependencies) {
+        if (!dependency) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (!dependency->finished) {
+            job->pendingDependencies.fetch_add(1);
+            dependency->continuations.push_back(job);
+        }
+    }
+
+    // Drop the scheduling guard. If every dependency already finished the job is ready now.
+    if (job->pendingDependencies.fetch_sub(1) == 1) {
+        enqueue(job);
+    }
+    return job;
+}
+
+void JobSystem::wait(const JobHandle& job) {
+    if (!job) {
+        return;
+    }
+    const std::size_t queueIndex = currentQueue();
+    while (!job->finished.load(std::memory_order_acquire)) {
+        if (JobHandle next = popOrSteal(queueIndex)) {
+            execute(next);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    if (job->exception) {
+        std::rethrow_exception(job->exception);
+    }
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle>& jobs) {
+    std::exception_ptr exception;
+    for (const auto& job : jobs) {
+        try {
+            wait(job);
+        }
+        catch (...) {
+            if (!exception) {
+                exception = std::current_exception();
+            }
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void JobSystem::enqueue(JobHandle job) {
+    WorkQueue& queue = *m_queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queuedJobs.fetch_add(1);
+    }
+    m_wakeCondition.notify_one();
+}
+
+void JobSystem::execute(const JobHandle& job) {
+    // A throwing job still has to finish, or everything waiting on it would spin forever
+    try {
+        job->work();
+    }
+    catch (...) {
+        job->exception = std::current_exception();
+    }
+    job->work = nullptr;
+
+    std::vector<JobHandle> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->continuationMutex);
+        job->finished.store(true, std::memory_order_release);
+        ready.swap(job->continuations);
+    }
+    for (auto& continuation : ready) {
+        if (continuation->pendingDependencies.fetch_sub(1) == 1) {
+            enqueue(std::move(continuation));
+        }
+    }
+}
+
+JobHandle JobSystem::popOrSteal(std::size_t queueIndex) {
+    // Own queue first, newest job
+    {
+        WorkQueue& own = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            JobHandle job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            m_queuedJobs.fetch_sub(1);
+            return job;
+        }
+    }
+    // Then the oldest job from someone else, starting with the next queue along
+    for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+        WorkQueue& victim = *m_queues[(queueIndex + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            JobHandle job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            m_queuedJobs.fetch_sub(1);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::workerLoop(std::size_t queueIndex) {
+    t_queueIndex = queueIndex;
+    while (true) {
+        if (JobHandle job = popOrSteal(queueIndex)) {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait(lock, [this]() { return m_stopping || m_queuedJobs.load() > 0; });
+        if (m_stopping) {
+            return;
+        }
+    }
+}
+
+std::size_t JobSystem::currentQueue() const {
+    return t_queueIndex;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <cstddef>
+
+// A unit of work plus the bookkeeping needed to chain other jobs after it
+struct Job {
+    std::function<void()> work;
+    // Jobs this one still waits on, plus one guard held while it is being scheduled
+    std::atomic<int> pendingDependencies{ 1 };
+    std::atomic<bool> finished{ false };
+    // Set when work threw, rethrown by JobSystem::wait. Written before finished.
+    std::exception_ptr exception;
+    std::mutex continuationMutex;
+    std::vector<std::shared_ptr<Job>> continuations;
+};
+
+using JobHandle = std::shared_ptr<Job>;
+
+// Work-stealing thread pool shared by the engine. Each worker owns a deque: it pushes and
+// pops at the back (newest first, still warm in cache) while idle workers steal from the
+// front. The main thread has its own deque and helps out whenever it waits on a job.
+class JobSystem {
+public:
+    // The engine's shared pool, with defaultWorkerCount() workers
+    static JobSystem& getInstance();
+    // One less than the hardware threads, the main thread is the last one
+    static std::size_t defaultWorkerCount();
+
+    // Separate pools are for measuring, e.g. scaling over worker counts. 0 workers runs
+    // everything on the calling thread.
+    explicit JobSystem(std::size_t workerCount);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Queues work to run once every dependency has finished
+    JobHandle schedule(std::function<void()> work, const std::vector<JobHandle>& dependencies = {});
+
+    // Runs other queued jobs until the given one has finished. If the job threw, the
+    // exception is rethrown here. Jobs that depend on a failed job still run.
+    void wait(const JobHandle& job);
+    // Waits for every job, even after one has failed, then rethrows the first exception
+    void waitAll(const std::vector<JobHandle>& jobs);
+
+    // Calls fn(begin, end) over [0, count) in chunks of at least minChunk, spread across
+    // the workers, and returns when all chunks are done. Small ranges run inline. If fn
+    // throws, the first exception is rethrown once every chunk has finished.
+    template<typename Fn>
+    void parallelFor(std::size_t count, std::size_t minChunk, Fn&& fn);
+
+    // Worker threads, not counting the main thread
+    std::size_t workerCount() const { return m_workers.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    void enqueue(JobHandle job);
+    void execute(const JobHandle& job);
+    JobHandle popOrSteal(std::size_t queueIndex);
+    void workerLoop(std::size_t queueIndex);
+    std::size_t currentQueue() const;
+
+    // Index 0 belongs to the main thread, worker i uses i + 1
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<std::size_t> m_queuedJobs{ 0 };
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+    std::atomic<bool> m_stopping{ false };
+};
+
+template<typename Fn>
+void JobSystem::parallelFor(std::size_t count, std::size_t minChunk, Fn&& fn) {
+    if (count == 0) {
+        return;
+    }
+    const std::size_t threads = m_workers.size() + 1;
+    minChunk = std::max<std::size_t>(minChunk, 1);
+    if (threads == 1 || count <= minChunk) {
+        fn(std::size_t(0), count);
+        return;
+    }
+
+    // A few chunks per thread so a thief has something left to take
+    const std::size_t chunk = std::max(minChunk, (count + threads * 4 - 1) / (threads * 4));
+    std::vector<JobHandle> chunks;
+    chunks.reserve((count + chunk - 1) / chunk);
+    for (std::size_t begin = chunk; begin < count; begin += chunk) {
+        const std::size_t end = std::min(begin + chunk, count);
+        chunks.push_back(schedule([&fn, begin, end]() { fn(begin, end); }));
+    }
+    // The calling thread takes the first chunk itself. The other chunks hold a reference
+    // to fn, so they are waited on even if this one throws.
+    std::exception_ptr exception;
+    try {
+        fn(std::size_t(0), std::min(chunk, count));
+    }
+    catch (...) {
+        exception = std::current_exception();
+    }
+    try {
+        waitAll(chunks);
+    }
+    catch (...) {
+        if (!exception) {
+            exception = std::current_exception();
+        }
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
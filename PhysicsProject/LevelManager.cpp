@@ -11,7 +11,7 @@ void LevelManager::addLevel(SceneType sceneType) {
 void LevelManager::startCurrentLevel() {
    
     if (m_currentLevelIndex >= 0 && m_currentLevelIndex < m_levels.size()) {
-        m_game->createScene(m_levels[m_currentLevelIndex]);
+        m_game->requestScene(m_levels[m_currentLevelIndex]);
     }
 }
 
@@ -0,0 +1,95 @@
+#include "LevelSnapshot.h"
+#include "Component.h"
+#include "ComponentManager.h"
+#include "EntityManager.h"
+#include "Prefab.h"
+
+void LevelSnapshot::capture() {
+    m_entities.clear();
+    for (GameObject* gameObject : GameObject::getAllObjects()) {
+        if (gameObject->isDestroyed() || gameObject->hasComponent<AbilityComponent>()) {
+            continue;
+        }
+        auto transform = gameObject->getComponent<TransformComponent>();
+        if (!transform) {
+            continue;
+        }
+        auto breakable = gameObject->getComponent<BreakableComponent>();
+        m_entities.push_back({
+            gameObject->getEntity(),
+            gameObject->getPrefab(),
+            transform->getPosition(),
+            transform->getScale(),
+            transform->getRotation(),
+            breakable ? breakable->getHealth() : -1.0f
+            });
+    }
+    m_isValid = true;
+}
+
+void LevelSnapshot::clear() {
+    m_entities.clear();
+    m_isValid = false;
+}
+
+bool LevelSnapshot::restore() {
+    if (!m_isValid) {
+        return false;
+    }
+
+    std::vector<GameObject*> respawned;
+    for (auto& state : m_entities) {
+        GameObject* gameObject = GameObject::find(state.entity);
+        if (!gameObject || gameObject->isDestroyed()) {
+            if (!state.prefab) {
+                std::cout << "Can't restore an object that wasn't spawned from a prefab" << std::endl;
+                continue;
+            }
+            gameObject = state.prefab->instantiate(state.position);
+            state.entity = gameObject->getEntity();
+            respawned.push_back(gameObject);
+        }
+
+        auto transform = gameObject->getComponent<TransformComponent>();
+        // setScale rebuilds the box fixture, so leave it alone unless it actually changed
+        if (transform->getScale() != state.scale) {
+            transform->setScale(state.scale.x, state.scale.y);
+        }
+        transform->setRotation(state.rotation);
+        transform->setPosition(state.position.x, state.position.y);
+
+        auto rigidBody = gameObject->getComponent<RigidBodyComponent>();
+        if (rigidBody && rigidBody->GetBody()) {
+            b2Body* body = rigidBody->GetBody();
+            body->SetLinearVelocity(b2Vec2(0, 0));
+            body->SetAngularVelocity(0);
+            body->SetAwake(true);
+        }
+
+        if (state.health >= 0.0f) {
+            if (auto breakable = gameObject->getComponent<BreakableComponent>()) {
+                breakable->setHealth(state.health);
+            }
+        }
+    }
+
+    for (GameObject* gameObject : respawned) {
+        gameObject->start();
+    }
+
+    ComponentManager::getInstance().forEach<BirdLauncherComponent>([](GameObject*, BirdLauncherComponent* launcher) {
+        launcher->restart();
+        });
+
+    // Everything else (launched birds, split birds, the lose screen) goes at the next flush
+    m_isRecorded.assign(EntityManager::getInstance().capacity(), 0);
+    for (const auto& state : m_entities) {
+        m_isRecorded[state.entity.index()] = 1;
+    }
+    for (GameObject* gameObject : GameObject::getAllObjects()) {
+        if (!m_isRecorded[gameObject->getEntity().index()]) {
+            gameObject->destroy();
+        }
+    }
+    return true;
+}
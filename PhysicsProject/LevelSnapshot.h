@@ -0,0 +1,37 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "Entity.h"
+
+class Prefab;
+
+// State of every object right after a level was built. Retry puts it back in place:
+// surviving objects are moved back and keep their bodies and textures, destroyed ones
+// are respawned from their prefab, and anything spawned since is destroyed. Birds are
+// not recorded, the launchers restart instead.
+class LevelSnapshot {
+public:
+    // Call at a sync point once the level's objects have been flushed and started
+    void capture();
+    void clear();
+    bool isValid() const { return m_isValid; }
+
+    // Returns false if there is nothing to restore. Call at a sync point and flush after.
+    bool restore();
+
+private:
+    struct EntityState {
+        Entity entity;
+        const Prefab* prefab;
+        sf::Vector2f position;
+        sf::Vector2f scale;
+        float rotation;
+        // Negative when the object has no BreakableComponent
+        float health;
+    };
+
+    std::vector<EntityState> m_entities;
+    // Scratch for restore, indexed by Entity::index()
+    std::vector<char> m_isRecorded;
+    bool m_isValid = false;
+};
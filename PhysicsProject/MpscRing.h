@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Bounded lock-free queue for many producers and a single consumer. Every cell carries a
+// sequence number: producers claim a cell by advancing the tail with a CAS, write the
+// value, then publish it by bumping the sequence. The consumer reads cells in order and
+// hands them back one lap ahead. Storage is fixed, nothing allocates after construction.
+template<typename T, std::size_t Capacity>
+class MpscRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "Ring entries are copied in and out");
+
+public:
+    MpscRing() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Safe from any thread. Returns false when the ring is full.
+    bool push(const T& value) {
+        std::size_t position = m_tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = m_cells[position & (Capacity - 1)];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only. Returns false when the ring is empty.
+    bool pop(T& value) {
+        Cell& cell = m_cells[m_head & (Capacity - 1)];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != m_head + 1) {
+            return false;
+        }
+        value = cell.value;
+        cell.sequence.store(m_head + Capacity, std::memory_order_release);
+        ++m_head;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::array<Cell, Capacity> m_cells;
+    // Producers and the consumer live on different cache lines
+    alignas(64) std::atomic<std::size_t> m_tail{ 0 };
+    alignas(64) std::size_t m_head = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+
+// Slab allocator for objects of a single type. Slots come from a free list, or from a
+// bump cursor over the slabs when the free list is empty. Slabs never move, so pointers
+// stay valid until the object is released.
+template<typename T, std::size_t SlabSize = 256>
+class ObjectPool {
+public:
+    ObjectPool() = default;
+    ~ObjectPool() { releaseAll(); }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = m_freeList;
+        if (slot) {
+            m_freeList = slot->next;
+        }
+        else {
+            if (m_cursor == m_slabs.size() * SlabSize) {
+                m_slabs.push_back(std::make_unique<Slot[]>(SlabSize));
+            }
+            slot = &m_slabs[m_cursor / SlabSize][m_cursor % SlabSize];
+            ++m_cursor;
+        }
+
+        T* object;
+        try {
+            object = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            slot->next = m_freeList;
+            m_freeList = slot;
+            throw;
+        }
+        slot->epoch = m_epoch;
+        ++m_liveCount;
+        ++m_totalCreated;
+        return object;
+    }
+
+    void release(T* object) {
+        if (!object) {
+            return;
+        }
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        object->~T();
+        slot->epoch = 0;
+        slot->next = m_freeList;
+        m_freeList = slot;
+        --m_liveCount;
+    }
+
+    // Destroys every live object and reclaims all slots at once. Reclaiming is O(1): bumping
+    // the epoch marks every slot free without rebuilding the free list. Destruction is not,
+    // types with a non-trivial destructor (GameObject included) still visit each used slot.
+    void releaseAll() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            forEach([](T& object) { object.~T(); });
+        }
+        ++m_epoch;
+        m_freeList = nullptr;
+        m_cursor = 0;
+        m_liveCount = 0;
+    }
+
+    // Visits live objects in slot order
+    template<typename Fn>
+    void forEach(Fn&& fn) {
+        for (std::size_t i = 0; i < m_cursor; ++i) {
+            Slot& slot = m_slabs[i / SlabSize][i % SlabSize];
+            if (slot.epoch == m_epoch) {
+                fn(*std::launder(reinterpret_cast<T*>(slot.storage)));
+            }
+        }
+    }
+
+    std::size_t liveCount() const { return m_liveCount; }
+    std::size_t totalCreated() const { return m_totalCreated; }
+    std::size_t capacity() const { return m_slabs.size() * SlabSize; }
+    std::size_t reservedBytes() const { return capacity() * sizeof(Slot); }
+
+private:
+    struct Slot {
+        union {
+            Slot* next;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+        // Matches the pool epoch while the slot holds a live object
+        std::uint32_t epoch;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> m_slabs;
+    Slot* m_freeList = nullptr;
+    std::size_t m_cursor = 0;
+    std::size_t m_liveCount = 0;
+    std::size_t m_totalCreated = 0;
+    std::uint32_t m_epoch = 1;
+};
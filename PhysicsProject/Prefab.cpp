@@ -0,0 +1,34 @@
+#include "Prefab.h"
+
+Prefab::Prefab(std::string name)
+    : m_name(std::move(name)) {}
+
+Prefab& Prefab::withScale(const sf::Vector2f& scale) {
+    m_scale = scale;
+    return *this;
+}
+
+GameObject* Prefab::instantiate(const sf::Vector2f& position) const {
+    return spawnBatch(std::span<const sf::Vector2f>(&position, 1)).front();
+}
+
+std::vector<GameObject*> Prefab::spawnBatch(std::span<const sf::Vector2f> positions) const {
+    std::vector<GameObject*> objects;
+    objects.reserve(positions.size());
+    for (const auto& position : positions) {
+        GameObject* gameObject = GameObject::create(position, m_name);
+        gameObject->setPrefab(this);
+        auto transform = gameObject->addComponent<TransformComponent>(position.x, position.y);
+        if (m_scale) {
+            transform->setScale(m_scale->x, m_scale->y);
+        }
+        objects.push_back(gameObject);
+    }
+
+    for (const auto& step : m_steps) {
+        for (GameObject* gameObject : objects) {
+            step(gameObject);
+        }
+    }
+    return objects;
+}
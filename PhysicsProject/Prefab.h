@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <optional>
+#include "GameObject.h"
+#include "Component.h"
+
+// Blueprint for an entity. Components are built once as prototypes when the prefab is
+// set up, and every instance copy-constructs them straight into the component pools, so
+// spawning never reloads textures or re-runs constructor logic. The transform is the
+// one exception: each instance gets a fresh one at its spawn position (see withScale).
+class Prefab {
+public:
+    explicit Prefab(std::string name);
+    Prefab(Prefab&&) = default;
+    Prefab& operator=(Prefab&&) = default;
+
+    template<typename T, typename... Args>
+    Prefab& add(Args&&... args);
+
+    // Scale given to each instance's transform. Without it the transform keeps its default.
+    Prefab& withScale(const sf::Vector2f& scale);
+
+    GameObject* instantiate(const sf::Vector2f& position) const;
+
+    // Creates one object per position. Components are added a type at a time across the
+    // whole batch, so each pool is filled in one run.
+    std::vector<GameObject*> spawnBatch(std::span<const sf::Vector2f> positions) const;
+
+    const std::string& getName() const { return m_name; }
+
+private:
+    std::string m_name;
+    std::optional<sf::Vector2f> m_scale;
+    std::vector<std::unique_ptr<Component>> m_prototypes;
+    std::vector<std::function<void(GameObject*)>> m_steps;
+};
+
+template<typename T, typename... Args>
+Prefab& Prefab::add(Args&&... args) {
+    static_assert(std::is_base_of_v<Component, T>, "Prefabs can only hold components");
+    static_assert(!std::is_same_v<T, TransformComponent>, "The transform comes from the spawn position, use withScale instead");
+    static_assert(std::is_copy_constructible_v<T>, "Prefab components are copied from their prototype");
+
+    auto prototype = std::make_unique<T>(std::forward<Args>(args)...);
+    const T* source = prototype.get();
+    m_prototypes.push_back(std::move(prototype));
+    m_steps.push_back([source](GameObject* gameObject) {
+        gameObject->addComponent<T>(*source);
+        });
+    return *this;
+}
@@ -12,6 +12,8 @@ RigidBodyComponent::RigidBodyComponent(Box2DWorld* world, float mass, float grav
 
 RigidBodyComponent::~RigidBodyComponent() {
     if (m_body && m_world) {
+        // The transform may outlive the body, don't leave it holding a dangling pointer
+        TransformStorage::getInstance().detachBody(getOwner()->getEntity().index(), m_body);
         m_world->GetWorld()->DestroyBody(m_body);
     }
 }
@@ -21,22 +23,12 @@ void RigidBodyComponent::init(){
     createBody();
 }
 
+// The pose is copied by TransformStorage::syncFromBodies, this only retries a body
+// whose creation was deferred because the transform wasn't there yet
 void RigidBodyComponent::update(float deltaTime) {
     if (!m_body) {
         createBody();
     }
-
-    if (m_body) {
-        b2Vec2 position = m_body->GetPosition();
-        float angle = m_body->GetAngle();
-
-        auto transform = getOwner()->getComponent<TransformComponent>();
-        
-        if (transform) {
-            transform->position = sf::Vector2f(position.x * 30.0f, position.y * 30.0f);
-            transform->rotation = angle * 180.0f / b2_pi;
-        }
-    }
 }
 void RigidBodyComponent::createBody() {
     if (m_body) return;
@@ -49,8 +41,8 @@ void RigidBodyComponent::createBody() {
 
     b2BodyDef bodyDef;
     bodyDef.type = b2_dynamicBody;
-    bodyDef.position.Set(transform->position.x / 30.0f, transform->position.y / 30.0f);
-    bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(getOwner());
+    bodyDef.position.Set(transform->getPosition().x / 30.0f, transform->getPosition().y / 30.0f);
+    bodyDef.userData.pointer = getOwner()->getEntity().id;
 
     m_body = m_world->GetWorld()->CreateBody(&bodyDef);
 
@@ -60,6 +52,7 @@ void RigidBodyComponent::createBody() {
     }
 
     m_body->SetGravityScale(m_gravityScale);
+    transform->attachBody(m_body);
 
     // Find and initialize the collider component
     auto circleCollider = getOwner()->getComponent<CircleColliderComponent>();
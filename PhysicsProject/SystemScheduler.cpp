@@ -0,0 +1,98 @@
+#include "SystemScheduler.h"
+#include "JobSystem.h"
+#include <SFML/System/Clock.hpp>
+#include <iostream>
+#include <algorithm>
+
+namespace {
+    bool conflicts(const SystemDesc& a, const SystemDesc& b) {
+        if (a.mainThreadOnly && b.mainThreadOnly) {
+            return true;
+        }
+        return (a.writes & (b.reads | b.writes)).any() || (b.writes & a.reads).any();
+    }
+}
+
+void SystemScheduler::addSystem(SystemDesc system) {
+    m_timings.push_back({ system.name, system.phase, 0.0f });
+    m_systems.push_back(std::move(system));
+    m_dirty = true;
+}
+
+void SystemScheduler::buildBatches() {
+    m_batches.assign(static_cast<std::size_t>(SystemPhase::Count), {});
+    // Batch each system was placed in, only meaningful within its own phase
+    std::vector<std::size_t> level(m_systems.size(), 0);
+
+    for (std::size_t i = 0; i < m_systems.size(); ++i) {
+        const SystemDesc& system = m_systems[i];
+        std::size_t batch = 0;
+        for (std::size_t j = 0; j < i; ++j) {
+            if (m_systems[j].phase == system.phase && conflicts(m_systems[j], system)) {
+                batch = std::max(batch, level[j] + 1);
+            }
+        }
+        level[i] = batch;
+
+        auto& phaseBatches = m_batches[static_cast<std::size_t>(system.phase)];
+        if (batch >= phaseBatches.size()) {
+            phaseBatches.resize(batch + 1);
+        }
+        phaseBatches[batch].push_back(i);
+    }
+    m_dirty = false;
+}
+
+void SystemScheduler::run(float deltaTime, SystemPhase first, SystemPhase last) {
+    if (m_dirty) {
+        buildBatches();
+    }
+
+    auto& jobSystem = JobSystem::getInstance();
+    for (std::size_t phase = static_cast<std::size_t>(first); phase <= static_cast<std::size_t>(last); ++phase) {
+        for (const auto& batch : m_batches[phase]) {
+            if (batch.size() == 1) {
+                runSystem(batch.front(), deltaTime);
+                continue;
+            }
+
+            m_jobs.clear();
+            for (std::size_t systemIndex : batch) {
+                if (!m_systems[systemIndex].mainThreadOnly) {
+                    m_jobs.push_back(jobSystem.schedule([this, systemIndex, deltaTime]() { runSystem(systemIndex, deltaTime); }));
+                }
+            }
+            for (std::size_t systemIndex : batch) {
+                if (m_systems[systemIndex].mainThreadOnly) {
+                    runSystem(systemIndex, deltaTime);
+                }
+            }
+            jobSystem.waitAll(m_jobs);
+            // Let the finished jobs go now rather than holding them until the next batch
+            m_jobs.clear();
+        }
+    }
+}
+
+void SystemScheduler::runSystem(std::size_t systemIndex, float deltaTime) {
+    sf::Clock clock;
+    m_systems[systemIndex].run(deltaTime);
+    m_timings[systemIndex].milliseconds = clock.getElapsedTime().asMicroseconds() / 1000.0f;
+}
+
+void SystemScheduler::printTimings() const {
+    for (const auto& timing : m_timings) {
+        std::cout << phaseName(timing.phase) << " / " << timing.name << ": " << timing.milliseconds << " ms" << std::endl;
+    }
+}
+
+const char* SystemScheduler::phaseName(SystemPhase phase) {
+    switch (phase) {
+    case SystemPhase::Input: return "Input";
+    case SystemPhase::PrePhysics: return "PrePhysics";
+    case SystemPhase::Physics: return "Physics";
+    case SystemPhase::PostPhysics: return "PostPhysics";
+    case SystemPhase::RenderPrep: return "RenderPrep";
+    default: return "Unknown";
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstddef>
+#include "ComponentType.h"
+#include "JobSystem.h"
+
+enum class SystemPhase {
+    Input,
+    PrePhysics,
+    Physics,
+    PostPhysics,
+    RenderPrep,
+    Count
+};
+
+// What a system touches, so the scheduler knows which systems may run side by side.
+// Two systems conflict if either writes a type the other reads or writes.
+struct SystemDesc {
+    std::string name;
+    SystemPhase phase = SystemPhase::PrePhysics;
+    ComponentSignature reads;
+    ComponentSignature writes;
+    // Systems that poll the window, step Box2D or create/destroy objects must stay on the
+    // main thread. They still run in their phase order, just never on a worker.
+    bool mainThreadOnly = false;
+    std::function<void(float)> run;
+};
+
+struct SystemTiming {
+    std::string name;
+    SystemPhase phase;
+    float milliseconds;
+};
+
+// Runs the registered systems phase by phase. Inside a phase, systems are ordered by
+// registration, and each one lands in the first batch after every earlier system it
+// conflicts with. The systems in a batch don't conflict and are spread over the job system.
+// Queries used by worker-side systems should be created (view<>()) before the first run.
+class SystemScheduler {
+public:
+    void addSystem(SystemDesc system);
+    // Runs every phase from first to last inclusive
+    void run(float deltaTime, SystemPhase first = SystemPhase::Input, SystemPhase last = SystemPhase::RenderPrep);
+
+    // Wall time of each system in the last frame, in registration order
+    const std::vector<SystemTiming>& getTimings() const { return m_timings; }
+    void printTimings() const;
+
+    static const char* phaseName(SystemPhase phase);
+
+private:
+    void buildBatches();
+    void runSystem(std::size_t systemIndex, float deltaTime);
+
+    std::vector<SystemDesc> m_systems;
+    std::vector<SystemTiming> m_timings;
+    // Per phase, a list of batches, each a list of indices into m_systems
+    std::vector<std::vector<std::vector<std::size_t>>> m_batches;
+    bool m_dirty = true;
+    // Jobs of the batch being run, kept so its capacity is reused from frame to frame
+    std::vector<JobHandle> m_jobs;
+};
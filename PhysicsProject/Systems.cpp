@@ -1,6 +1,7 @@
 #pragma once
 #include "Systems.h"
 #include <cmath>
+#include <algorithm>
 #include "EventSystem.h"
 
 
@@ -9,58 +10,137 @@
 
 
 
+RenderSystem::RenderSystem() {
+    m_damageSubscription = GameplayEventQueue::getInstance().subscribe(GameplayEventType::Damage, [](const GameplayEvent& event) {
+        if (GameObject* gameObject = GameObject::find(event.entity)) {
+            if (auto breakable = gameObject->getComponent<BreakableComponent>()) {
+                breakable->updateTint();
+            }
+        }
+        });
+}
+
+RenderSystem::~RenderSystem() {
+    GameplayEventQueue::getInstance().unsubscribe(m_damageSubscription);
+}
+
 void RenderSystem::update(sf::RenderWindow& window) {
-    for (auto& gameObject : GameObject::getAllObjects()) {
-        drawGameObject(window, gameObject);
-    }
+    drawAll(window, RenderableComponents{});
 }
 
-void RenderSystem::drawGameObject(sf::RenderWindow& window, GameObject* gameObject) {
-    auto transform = gameObject->getComponent<TransformComponent>();
+template<typename... Ts>
+void RenderSystem::drawAll(sf::RenderWindow& window, TypeList<Ts...>) {
+    auto& componentManager = ComponentManager::getInstance();
+    (componentManager.forEachInPool<Ts>([&window](Ts& component) { draw(window, component); }), ...);
+}
+
+template<typename... Ts>
+void RenderSystem::drawOwned(sf::RenderWindow& window, GameObject* gameObject, TypeList<Ts...>) {
+    auto& componentManager = ComponentManager::getInstance();
+    ((componentManager.hasComponent<Ts>(gameObject) ? draw(window, *componentManager.getComponent<Ts>(gameObject)) : void()), ...);
+}
 
-    auto render = gameObject->getComponent<RenderComponent>();
-    if (transform && render) {
-        render->shape.setPosition(transform->position);
-        render->shape.setScale(transform->scale);
-        render->shape.setRotation(transform->rotation);
+void RenderSystem::prepareShapes() {
+    const auto& storage = TransformStorage::getInstance();
+    ComponentManager::getInstance().forEach<TransformComponent, RenderComponent>([&storage](GameObject*, TransformComponent* transform, RenderComponent* render) {
+        // The tint changes without touching the transform, so it is applied regardless
         render->shape.setFillColor(render->color);
-        window.draw(render->shape);
-    }
+        if (!storage.isRenderDirty(transform->getSlot())) {
+            return;
+        }
+        render->shape.setPosition(transform->getDrawPosition());
+        render->shape.setScale(transform->getScale());
+        render->shape.setRotation(transform->getDrawRotation());
+        });
+}
 
-    auto spriteRenderer = gameObject->getComponent<SpriteRendererComponent>();
-    if (transform && spriteRenderer) {
-        spriteRenderer->updateTransformScale(transform->scale);
-        spriteRenderer->getSprite().setPosition(transform->position);
-        spriteRenderer->getSprite().setRotation(transform->rotation);
-        window.draw(spriteRenderer->getSprite());
-    }
+void RenderSystem::prepareSprites() {
+    const auto& storage = TransformStorage::getInstance();
+    ComponentManager::getInstance().forEach<TransformComponent, SpriteRendererComponent>([&storage](GameObject*, TransformComponent* transform, SpriteRendererComponent* spriteRenderer) {
+        if (!storage.isRenderDirty(transform->getSlot())) {
+            return;
+        }
+        spriteRenderer->updateTransformScale(transform->getScale());
+        spriteRenderer->getSprite().setPosition(transform->getDrawPosition());
+        spriteRenderer->getSprite().setRotation(transform->getDrawRotation());
+        });
+}
 
-    auto boxCollider = gameObject->getComponent<BoxColliderComponent>();
-    if (boxCollider) {
-        boxCollider->debugDraw(window);
-    }
+void RenderSystem::drawGameObject(sf::RenderWindow& window, GameObject* gameObject) {
+    drawOwned(window, gameObject, RenderableComponents{});
+}
 
-    auto circleCollider = gameObject->getComponent<CircleColliderComponent>();
-    if (circleCollider) {
-        circleCollider->debugDraw(window);
-    }
+void RenderSystem::draw(sf::RenderWindow& window, RenderComponent& render) {
+    window.draw(render.shape);
+}
 
-    auto launcherRope = gameObject->getComponent<BirdLauncherComponent>();
-    if (launcherRope) {
-        launcherRope->drawRope(window);
-    }
+void RenderSystem::draw(sf::RenderWindow& window, SpriteRendererComponent& spriteRenderer) {
+    window.draw(spriteRenderer.getSprite());
+}
+
+void RenderSystem::draw(sf::RenderWindow& window, CircleColliderComponent& circleCollider) {
+    circleCollider.debugDraw(window);
+}
 
-    auto textRenderer = gameObject->getComponent<TextRendererComponent>();
-    if (textRenderer) {
-        textRenderer->draw(window);
+void RenderSystem::draw(sf::RenderWindow& window, BoxColliderComponent& boxCollider) {
+    boxCollider.debugDraw(window);
+}
+
+void RenderSystem::draw(sf::RenderWindow& window, BirdLauncherComponent& launcher) {
+    launcher.drawRope(window);
+}
+
+void RenderSystem::draw(sf::RenderWindow& window, TextRendererComponent& textRenderer) {
+    textRenderer.draw(window);
+}
+
+void RenderSystem::draw(sf::RenderWindow& window, ButtonComponent& button) {
+    button.draw(window);
+}
+void DamageSystem::accumulate(const ContactEvent& event) {
+    add(event.entityA, event.entityB, event.normalImpulse);
+    add(event.entityB, event.entityA, event.normalImpulse);
+}
+
+void DamageSystem::add(Entity entity, Entity source, float impulse) {
+    if (entity.isNull()) {
+        return;
+    }
+    const std::uint32_t index = entity.index();
+    if (index >= m_impulses.size()) {
+        const std::size_t size = std::max<std::size_t>(index + 1, EntityManager::getInstance().capacity());
+        m_impulses.resize(size, 0.0f);
+        m_sources.resize(size);
+        m_strongestHits.resize(size, 0.0f);
     }
+    if (m_impulses[index] == 0.0f) {
+        m_hitEntities.push_back(entity);
+    }
+    m_impulses[index] += impulse;
+    if (impulse > m_strongestHits[index]) {
+        m_strongestHits[index] = impulse;
+        m_sources[index] = source;
+    }
+}
 
-    auto buttonComponent = gameObject->getComponent<ButtonComponent>();
-    if (buttonComponent) {
-        buttonComponent->draw(window);
+void DamageSystem::apply() {
+    for (Entity entity : m_hitEntities) {
+        const std::uint32_t index = entity.index();
+        if (GameObject* gameObject = GameObject::find(entity)) {
+            if (auto breakable = gameObject->getComponent<BreakableComponent>()) {
+                breakable->applyDamage(m_impulses[index] * m_damagePerImpulse, m_sources[index]);
+            }
+        }
+        m_impulses[index] = 0.0f;
+        m_strongestHits[index] = 0.0f;
+        m_sources[index] = Entity{};
     }
+    m_hitEntities.clear();
 }
+
 PhysicsSystem::PhysicsSystem() {
+    m_world.GetWorld()->SetContactListener(&m_contactEvents);
+
     // Create ground body
     b2BodyDef groundBodyDef;
 
@@ -82,49 +162,139 @@ void PhysicsSystem::createWall(float x1, float y1, float x2, float y2) {
     wallShape.SetTwoSided(b2Vec2(x1, y1), b2Vec2(x2, y2));
     wallBody->CreateFixture(&wallShape, 0.0f);
 }
+void PhysicsSystem::setTickRate(float ticksPerSecond) {
+    m_fixedStep = 1.0f / std::max(ticksPerSecond, 1.0f);
+}
+
+void PhysicsSystem::setMaxSubsteps(int maxSubsteps) {
+    m_maxSubsteps = std::max(maxSubsteps, 1);
+}
+
+PhysicsSystem::~PhysicsSystem() {
+    setThreaded(false);
+}
+
+void PhysicsSystem::setThreaded(bool threaded) {
+    if (threaded == isThreaded()) {
+        return;
+    }
+    if (threaded) {
+        m_isStopping = false;
+        m_simThread = std::thread(&PhysicsSystem::simulationLoop, this);
+        std::cout << "Physics stepping on a simulation thread" << std::endl;
+        return;
+    }
+    {
+        // Let the ticks in flight finish, their contacts are dropped by the next advance()
+        std::unique_lock<std::mutex> lock(m_simMutex);
+        m_simCondition.wait(lock, [this]() { return !m_isStepLaunched; });
+        m_isStopping = true;
+    }
+    m_simCondition.notify_all();
+    m_simThread.join();
+}
+
 void PhysicsSystem::update(float deltaTime) {
-    m_world.Step(deltaTime, 6, 2);
-
-    // Update GameObject positions based on Box2D simulation
-    for (auto& gameObject : GameObject::getAllObjects()) {
-        auto rigidBody = gameObject->getComponent<RigidBodyComponent>();
-        auto transform = gameObject->getComponent<TransformComponent>();
-        if (rigidBody && transform) {
-             
-            if (!rigidBody->GetBody()) {
-                continue;
-            }
-            
-            b2Body* body = rigidBody->GetBody();
-            b2Vec2 position = body->GetPosition();
-            float angle = body->GetAngle();
-            transform->position = sf::Vector2f(position.x * 30.0f, position.y * 30.0f); // convert to pixels
-            transform->rotation = angle * 180.0f / b2_pi;
-        }
+    if (isThreaded()) {
+        m_pendingTime += deltaTime;
+        return;
+    }
+    advance(deltaTime, true);
+}
+
+void PhysicsSystem::launchStep() {
+    if (!isThreaded()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_simMutex);
+        m_isStepLaunched = true;
+    }
+    m_simCondition.notify_all();
+}
+
+void PhysicsSystem::waitForStep() {
+    if (!isThreaded()) {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_simMutex);
+        m_simCondition.wait(lock, [this]() { return !m_isStepLaunched; });
     }
+    m_pendingTime = 0.0f;
+    resolveContacts();
+}
 
-    // Handle collisions
-    for (b2Contact* contact = m_world.GetWorld()->GetContactList(); contact; contact = contact->GetNext()) {
-        if (contact->IsTouching()) {
-            resolveCollision(contact);
+void PhysicsSystem::simulationLoop() {
+    std::unique_lock<std::mutex> lock(m_simMutex);
+    while (true) {
+        m_simCondition.wait(lock, [this]() { return m_isStepLaunched || m_isStopping; });
+        if (m_isStopping) {
+            return;
         }
+        // The main thread leaves the world alone until m_isStepLaunched is cleared
+        lock.unlock();
+        advance(m_pendingTime, false);
+        lock.lock();
+        m_isStepLaunched = false;
+        m_simCondition.notify_all();
     }
+}
 
-    
+void PhysicsSystem::advance(float deltaTime, bool resolveEachStep) {
+    // Anything recorded outside a tick (bodies destroyed at the sync point) is stale
+    m_contactEvents.clear();
+    m_accumulator += deltaTime;
+    int substeps = 0;
+    while (m_accumulator >= m_fixedStep && substeps < m_maxSubsteps) {
+        step();
+        if (resolveEachStep) {
+            // A breakable destroyed this tick stops taking damage before the next one
+            resolveContacts();
+        }
+        m_accumulator -= m_fixedStep;
+        ++substeps;
+    }
+    if (m_accumulator >= m_fixedStep) {
+        // Fell behind, drop the backlog but keep the partial tick for interpolation
+        m_accumulator = std::fmod(m_accumulator, m_fixedStep);
+    }
 }
-void PhysicsSystem::resolveCollision(b2Contact* contact) {
 
-    b2Fixture* fixtureA = contact->GetFixtureA();
-    b2Fixture* fixtureB = contact->GetFixtureB();
-    b2Body* bodyA = fixtureA->GetBody();
-    b2Body* bodyB = fixtureB->GetBody();
+void PhysicsSystem::step() {
+    m_contactEvents.beginStep();
+    m_world.Step(m_fixedStep, 6, 2);
 
-    GameObject* objA = reinterpret_cast<GameObject*>(bodyA->GetUserData().pointer);
-    GameObject* objB = reinterpret_cast<GameObject*>(bodyB->GetUserData().pointer);
+    // Update transforms from the bodies Box2D still considers awake
+    TransformStorage::getInstance().syncFromBodies(*m_world.GetWorld());
+}
+
+void PhysicsSystem::resolveContacts() {
+    const auto& events = m_contactEvents.getEvents();
+    const auto& stepStarts = m_contactEvents.getStepStarts();
+    for (std::size_t step = 0; step < stepStarts.size(); ++step) {
+        const std::size_t end = step + 1 < stepStarts.size() ? stepStarts[step + 1] : events.size();
+        // Handle collisions, only contacts that started this step
+        for (std::size_t i = stepStarts[step]; i < end; ++i) {
+            if (events[i].type == ContactEvent::Type::Begin) {
+                resolveCollision(events[i]);
+            }
+            else if (events[i].type == ContactEvent::Type::PostSolve) {
+                m_damageSystem.accumulate(events[i]);
+            }
+        }
+        m_damageSystem.apply();
+    }
+    m_contactEvents.clear();
+}
+void PhysicsSystem::resolveCollision(const ContactEvent& event) {
+    // Bodies carry entity handles, so a body outliving its object resolves to nullptr
+    GameObject* objA = GameObject::find(event.entityA);
+    GameObject* objB = GameObject::find(event.entityB);
 
     if (objA && objB) {
-        auto colliderA = dynamic_cast<ICollider*>(objA->getComponent<ICollider>());
-        auto colliderB = dynamic_cast<ICollider*>(objB->getComponent<ICollider>());
+        auto colliderA = objA->getComponent<ICollider>();
+        auto colliderB = objB->getComponent<ICollider>();
 
         if (colliderA) colliderA->onCollision(objB);
         if (colliderB) colliderB->onCollision(objA);
@@ -139,17 +309,122 @@ EventSystem& EventSystem::getInstance() {
     return instance;
 }
 
-void EventSystem::addListener(Component* component) {
-    m_listeners.push_back(component);
+void EventSystem::addListener(Component* component, EventCategory::Mask categories) {
+    if (component->m_listenerSlot != Component::NoListenerSlot) {
+        return;
+    }
+
+    std::uint32_t slotIndex;
+    if (!m_freeSlots.empty()) {
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slotIndex = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    ListenerSlot& slot = m_slots[slotIndex];
+    slot.component = component;
+    slot.scene = m_scene;
+    for (std::size_t i = 0; i < EventCategory::Count; ++i) {
+        if (categories & (1 << i)) {
+            slot.positions[i] = static_cast<std::uint32_t>(m_listeners[i].size());
+            m_listeners[i].push_back(component);
+            m_listenerSlots[i].push_back(slotIndex);
+        }
+        else {
+            slot.positions[i] = NoPosition;
+        }
+    }
+    component->m_listenerSlot = slotIndex;
 }
 
 void EventSystem::removeListener(Component* component) {
-    m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), component), m_listeners.end());
+    const std::uint32_t slotIndex = component->m_listenerSlot;
+    if (slotIndex == Component::NoListenerSlot) {
+        return;
+    }
+
+    ListenerSlot& slot = m_slots[slotIndex];
+    for (std::size_t i = 0; i < EventCategory::Count; ++i) {
+        const std::uint32_t position = slot.positions[i];
+        if (position == NoPosition) {
+            continue;
+        }
+        // Move the last entry into the hole and point its slot at the new position
+        const std::uint32_t movedSlot = m_listenerSlots[i].back();
+        m_listeners[i][position] = m_listeners[i].back();
+        m_listenerSlots[i][position] = movedSlot;
+        m_slots[movedSlot].positions[i] = position;
+        m_listeners[i].pop_back();
+        m_listenerSlots[i].pop_back();
+    }
+
+    slot.component = nullptr;
+    m_freeSlots.push_back(slotIndex);
+    component->m_listenerSlot = Component::NoListenerSlot;
+}
+
+std::uint32_t EventSystem::beginScene() {
+    return m_scene++;
+}
+
+void EventSystem::removeListenersUpTo(std::uint32_t scene) {
+    for (std::uint32_t slotIndex = 0; slotIndex < m_slots.size(); ++slotIndex) {
+        ListenerSlot& slot = m_slots[slotIndex];
+        if (slot.component && slot.scene <= scene) {
+            slot.component->m_listenerSlot = Component::NoListenerSlot;
+            slot.component = nullptr;
+            m_freeSlots.push_back(slotIndex);
+        }
+    }
+
+    // Compact each list in place, keeping the survivors in order
+    for (std::size_t i = 0; i < EventCategory::Count; ++i) {
+        auto& listeners = m_listeners[i];
+        auto& listenerSlots = m_listenerSlots[i];
+        std::size_t kept = 0;
+        for (std::size_t position = 0; position < listeners.size(); ++position) {
+            const std::uint32_t slotIndex = listenerSlots[position];
+            if (!m_slots[slotIndex].component) {
+                continue;
+            }
+            listeners[kept] = listeners[position];
+            listenerSlots[kept] = slotIndex;
+            m_slots[slotIndex].positions[i] = static_cast<std::uint32_t>(kept);
+            ++kept;
+        }
+        listeners.resize(kept);
+        listenerSlots.resize(kept);
+    }
 }
 
 void EventSystem::dispatchEvent(const sf::Event& event) {
-    for (auto listener : m_listeners) {
-        listener->handleEvent(event);
+    const auto& listeners = m_listeners[categoryIndex(event.type)];
+    // Index instead of iterating, a handler may spawn objects that start listening
+    for (std::size_t i = 0; i < listeners.size(); ++i) {
+        listeners[i]->handleEvent(event);
+    }
+}
+
+std::size_t EventSystem::categoryIndex(sf::Event::EventType type) {
+    switch (type) {
+    case sf::Event::MouseButtonPressed:
+    case sf::Event::MouseButtonReleased:
+    case sf::Event::MouseWheelMoved:
+    case sf::Event::MouseWheelScrolled:
+        return 0;
+    case sf::Event::MouseMoved:
+    case sf::Event::MouseEntered:
+    case sf::Event::MouseLeft:
+        return 1;
+    case sf::Event::KeyPressed:
+    case sf::Event::KeyReleased:
+    case sf::Event::TextEntered:
+        return 2;
+    default:
+        return 3;
     }
 }
 
@@ -6,31 +6,141 @@
 #include "GameObject.h"
 #include "Component.h"
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "EventSystem.h"
 #include "Box2DWorld.h"
+#include "ContactEventBuffer.h"
+#include "GameplayEvents.h"
 
 class GameObject;
 class TransformComponent;
 class RigidBodyComponent;
 class BoxColliderComponent;
+class RenderComponent;
+class SpriteRendererComponent;
+class CircleColliderComponent;
+class BirdLauncherComponent;
+class TextRendererComponent;
+class ButtonComponent;
 const float SCREEN_WIDTH = 800.0f;
 const float SCREEN_HEIGHT = 600.0f;
 const float PIXELS_PER_METER = 30.0f;
+
+// Component types the render pass draws, in draw order. Each type is walked straight from
+// its own pool, so nothing asks an object for a component it doesn't have. A new
+// renderable needs an entry here and a RenderSystem::draw overload.
+using RenderableComponents = TypeList<RenderComponent, SpriteRendererComponent, CircleColliderComponent,
+    BoxColliderComponent, BirdLauncherComponent, TextRendererComponent, ButtonComponent>;
+
 class RenderSystem {
 public:
+    // Subscribes to Damage events to retint breakables, until destroyed
+    RenderSystem();
+    ~RenderSystem();
     void update(sf::RenderWindow& window);
+    // Render-prep: copy transforms into the drawables. They touch disjoint components, so
+    // the scheduler runs them side by side.
+    // They read the draw pose, so TransformStorage::publishDrawPoses must run first.
+    void prepareShapes();
+    void prepareSprites();
+    // Draws one object's renderables, checked against its signature
     void drawGameObject(sf::RenderWindow& window, GameObject* gameObject);
+
+private:
+    template<typename... Ts>
+    void drawAll(sf::RenderWindow& window, TypeList<Ts...>);
+    template<typename... Ts>
+    void drawOwned(sf::RenderWindow& window, GameObject* gameObject, TypeList<Ts...>);
+
+    static void draw(sf::RenderWindow& window, RenderComponent& render);
+    static void draw(sf::RenderWindow& window, SpriteRendererComponent& spriteRenderer);
+    static void draw(sf::RenderWindow& window, CircleColliderComponent& circleCollider);
+    static void draw(sf::RenderWindow& window, BoxColliderComponent& boxCollider);
+    static void draw(sf::RenderWindow& window, BirdLauncherComponent& launcher);
+    static void draw(sf::RenderWindow& window, TextRendererComponent& textRenderer);
+    static void draw(sf::RenderWindow& window, ButtonComponent& button);
+
+    GameplayEventQueue::SubscriptionToken m_damageSubscription;
+};
+// Turns contact impulses into breakable damage. Each PostSolve impulse is added to both
+// entities in a flat array indexed by entity, and the totals are applied once at the end
+// of the step, so the cost follows the number of impacts, not the number of contacts.
+class DamageSystem {
+public:
+    void accumulate(const ContactEvent& event);
+    void apply();
+    // Health lost per N*s of normal impulse
+    void setDamagePerImpulse(float damagePerImpulse) { m_damagePerImpulse = damagePerImpulse; }
+
+private:
+    void add(Entity entity, Entity source, float impulse);
+
+    // Indexed by Entity::index(), zero for entities not hit this step
+    std::vector<float> m_impulses;
+    // The other side of each entity's strongest hit this step
+    std::vector<Entity> m_sources;
+    std::vector<float> m_strongestHits;
+    std::vector<Entity> m_hitEntities;
+    float m_damagePerImpulse = 4.0f;
 };
+
 class PhysicsSystem {
 public:
     PhysicsSystem();
+    ~PhysicsSystem();
+    // Advances the world in fixed ticks. Frame time is accumulated and stepped off one
+    // tick at a time, at most m_maxSubsteps per frame; time beyond that is dropped so a
+    // hitch can't snowball into ever longer frames. When threaded, the time is only
+    // recorded here and stepped by launchStep().
     void update(float deltaTime);
-    void resolveCollision(b2Contact* contact);
+
+    // Threaded mode steps the world on a simulation thread while the main thread draws.
+    // The world is handed back and forth rather than shared: launchStep() gives it to the
+    // simulation thread once render prep is done, waitForStep() takes it back at the start
+    // of the next frame. Between the two, the main thread must not touch Box2D or the live
+    // transforms; drawing reads the draw pose published before the launch.
+    void setThreaded(bool threaded);
+    bool isThreaded() const { return m_simThread.joinable(); }
+    void launchStep();
+    // Blocks until the launched ticks are done, then resolves their contacts one tick at a
+    // time, as the unthreaded path does after each Step. Does nothing when not threaded or
+    // nothing was launched.
+    void waitForStep();
+    void setTickRate(float ticksPerSecond);
+    void setMaxSubsteps(int maxSubsteps);
+    float getFixedStep() const { return m_fixedStep; }
+    // How far the accumulator is into the next tick, used to interpolate rendering
+    float getInterpolationAlpha() const { return m_accumulator / m_fixedStep; }
+    // Calls onCollision on both sides of a contact that just started touching
+    void resolveCollision(const ContactEvent& event);
     Box2DWorld* GetWorld() { return &m_world; }
 
 private:
     void createWall(float x1, float y1, float x2, float y2);
+    // Runs the ticks owed for the given time, on whichever thread owns the world. Contacts
+    // are resolved after every tick when on the main thread, otherwise left buffered.
+    void advance(float deltaTime, bool resolveEachStep);
+    void step();
+    // Collision callbacks, then damage, for each tick buffered since the last clear
+    void resolveContacts();
+    void simulationLoop();
+    // Declared before the world so it outlives it
+    ContactEventBuffer m_contactEvents;
     Box2DWorld m_world;
+    DamageSystem m_damageSystem;
     b2Body* m_groundBody;
+    float m_fixedStep = 1.0f / 60.0f;
+    int m_maxSubsteps = 5;
+    float m_accumulator = 0.0f;
+
+    std::thread m_simThread;
+    std::mutex m_simMutex;
+    std::condition_variable m_simCondition;
+    // Frame time waiting to be stepped by the simulation thread
+    float m_pendingTime = 0.0f;
+    bool m_isStepLaunched = false;
+    bool m_isStopping = false;
 };
 #endif 
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "TextureCache.h"
+#include "JobSystem.h"
+#include <SFML/Graphics/Image.hpp>
+#include <stdexcept>
+#include <iostream>
+
+TextureCache& TextureCache::getInstance() {
+    static TextureCache instance;
+    return instance;
+}
+
+const sf::Texture& TextureCache::get(const std::string& path) {
+    auto it = m_textures.find(path);
+    if (it != m_textures.end()) {
+        return *it->second;
+    }
+
+    auto texture = std::make_unique<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        throw std::runtime_error("Failed to load texture: " + path);
+    }
+    return *m_textures.emplace(path, std::move(texture)).first->second;
+}
+
+void TextureCache::preload(const std::vector<std::string>& paths) {
+    std::vector<std::string> missing;
+    for (const auto& path : paths) {
+        if (m_textures.find(path) == m_textures.end()) {
+            missing.push_back(path);
+        }
+    }
+
+    // Image decoding is plain CPU work, only the upload needs the GL context
+    std::vector<sf::Image> images(missing.size());
+    std::vector<char> decoded(missing.size(), 0);
+    JobSystem::getInstance().parallelFor(missing.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            decoded[i] = images[i].loadFromFile(missing[i]);
+        }
+        });
+
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        auto texture = std::make_unique<sf::Texture>();
+        if (!decoded[i] || !texture->loadFromImage(images[i])) {
+            std::cout << "Error preloading texture: " << missing[i] << std::endl;
+            continue;
+        }
+        m_textures.emplace(missing[i], std::move(texture));
+    }
+}
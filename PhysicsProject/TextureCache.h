@@ -0,0 +1,26 @@
+#pragma once
+#include <SFML/Graphics/Texture.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// Loads each texture once and hands out shared references, so sprites created later
+// (prefab instances, split birds) never go back to disk. Textures live until shutdown.
+class TextureCache {
+public:
+    static TextureCache& getInstance();
+
+    // Loads on first use, throws std::runtime_error if the file can't be read
+    const sf::Texture& get(const std::string& path);
+
+    // Decodes any paths not cached yet on the job system, then uploads them on this thread
+    void preload(const std::vector<std::string>& paths);
+
+private:
+    TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> m_textures;
+};
@@ -2,20 +2,38 @@
 #include "Component.h"
 #include "Box2d/box2d.h"
 
-TransformComponent::TransformComponent(float x, float y) : position(x, y), scale(0.25f, 0.25f), rotation(0.0f), rigidBody(nullptr) {}
+TransformComponent::TransformComponent(float x, float y) : rigidBody(nullptr) {
+    m_slot = TransformStorage::getInstance().allocate(this, sf::Vector2f(x, y), sf::Vector2f(0.25f, 0.25f), 0.0f);
+}
+
+TransformComponent::TransformComponent(const TransformComponent& other) : Component(other), rigidBody(nullptr) {
+    m_slot = TransformStorage::getInstance().allocate(this, other.getPosition(), other.getScale(), other.getRotation());
+}
 
+TransformComponent::~TransformComponent() {
+    TransformStorage::getInstance().release(m_slot);
+}
+
+// Direct moves are teleports, so the previous pose snaps too and nothing is interpolated
 void TransformComponent::setPosition(float x, float y) {
-    position = sf::Vector2f(x, y);
+    auto& storage = TransformStorage::getInstance();
+    storage.positions[m_slot] = sf::Vector2f(x, y);
+    storage.previousPositions[m_slot] = sf::Vector2f(x, y);
+    storage.markRenderDirty(m_slot);
     updateBox2DBody();
 }
 
 void TransformComponent::setRotation(float angle) {
-    rotation = angle;
+    auto& storage = TransformStorage::getInstance();
+    storage.rotations[m_slot] = angle;
+    storage.previousRotations[m_slot] = angle;
+    storage.markRenderDirty(m_slot);
     updateBox2DBody();
 }
 
 void TransformComponent::setScale(float scaleX, float scaleY) {
-    scale = sf::Vector2f(scaleX, scaleY);
+    TransformStorage::getInstance().scales[m_slot] = sf::Vector2f(scaleX, scaleY);
+    TransformStorage::getInstance().markRenderDirty(m_slot);
     updateBox2DBody();
     auto box = getOwner()->getComponent<BoxColliderComponent>();
     if (box) {
@@ -23,12 +41,17 @@ void TransformComponent::setScale(float scaleX, float scaleY) {
     }
     }
 
+void TransformComponent::attachBody(b2Body* body) {
+    TransformStorage::getInstance().attachBody(m_slot, body);
+}
+
     void TransformComponent::updateBox2DBody() {
     if (!rigidBody) {
         rigidBody = getOwner()->getComponent<RigidBodyComponent>();
     }
     if (!rigidBody || !rigidBody->GetBody()) return;
 
+    const sf::Vector2f& position = getPosition();
     b2Vec2 pos(position.x / 30.0f, position.y / 30.0f);
-    rigidBody->GetBody()->SetTransform(pos, rotation * b2_pi / 180.0f);
+    rigidBody->GetBody()->SetTransform(pos, getRotation() * b2_pi / 180.0f);
 }
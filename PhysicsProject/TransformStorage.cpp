@@ -0,0 +1,174 @@
+#include "TransformStorage.h"
+#include "Component.h"
+#include "JobSystem.h"
+#include "box2d/box2d.h"
+#include "Entity.h"
+
+TransformStorage& TransformStorage::getInstance() {
+    static TransformStorage instance;
+    return instance;
+}
+
+namespace {
+    constexpr std::size_t NoSlot = static_cast<std::size_t>(-1);
+    constexpr std::uint32_t NoEntity = static_cast<std::uint32_t>(-1);
+
+    std::uint32_t entityIndexOf(b2Body* body) {
+        return Entity::fromId(static_cast<std::uint32_t>(body->GetUserData().pointer)).index();
+    }
+}
+
+std::size_t TransformStorage::allocate(TransformComponent* owner, const sf::Vector2f& position, const sf::Vector2f& scale, float rotation) {
+    positions.push_back(position);
+    scales.push_back(scale);
+    rotations.push_back(rotation);
+    bodies.push_back(nullptr);
+    previousPositions.push_back(position);
+    previousRotations.push_back(rotation);
+    drawPositions.push_back(position);
+    drawRotations.push_back(rotation);
+    m_owners.push_back(owner);
+    m_moving.push_back(0);
+    m_renderDirty.push_back(0);
+    m_bodyEntities.push_back(NoEntity);
+    const std::size_t slot = m_owners.size() - 1;
+    markRenderDirty(slot);
+    return slot;
+}
+
+void TransformStorage::release(std::size_t slot) {
+    if (m_bodyEntities[slot] != NoEntity) {
+        m_slotOfEntity[m_bodyEntities[slot]] = NoSlot;
+    }
+    const std::size_t last = m_owners.size() - 1;
+    if (slot != last) {
+        positions[slot] = positions[last];
+        scales[slot] = scales[last];
+        rotations[slot] = rotations[last];
+        bodies[slot] = bodies[last];
+        // Snapped rather than moved, the awake list from the last tick still names the old slot
+        previousPositions[slot] = positions[last];
+        previousRotations[slot] = rotations[last];
+        drawPositions[slot] = drawPositions[last];
+        drawRotations[slot] = drawRotations[last];
+        m_owners[slot] = m_owners[last];
+        m_owners[slot]->m_slot = slot;
+        m_moving[slot] = 0;
+        m_renderDirty[slot] = 0;
+        markRenderDirty(slot);
+        m_bodyEntities[slot] = m_bodyEntities[last];
+        if (m_bodyEntities[slot] != NoEntity) {
+            m_slotOfEntity[m_bodyEntities[slot]] = slot;
+        }
+    }
+    positions.pop_back();
+    scales.pop_back();
+    rotations.pop_back();
+    bodies.pop_back();
+    previousPositions.pop_back();
+    previousRotations.pop_back();
+    drawPositions.pop_back();
+    drawRotations.pop_back();
+    m_owners.pop_back();
+    m_moving.pop_back();
+    m_renderDirty.pop_back();
+    m_bodyEntities.pop_back();
+}
+
+void TransformStorage::attachBody(std::size_t slot, b2Body* body) {
+    bodies[slot] = body;
+    const std::uint32_t entityIndex = entityIndexOf(body);
+    if (entityIndex >= m_slotOfEntity.size()) {
+        m_slotOfEntity.resize(entityIndex + 1, NoSlot);
+    }
+    m_slotOfEntity[entityIndex] = slot;
+    m_bodyEntities[slot] = entityIndex;
+}
+
+void TransformStorage::detachBody(std::uint32_t entityIndex, const b2Body* body) {
+    if (entityIndex >= m_slotOfEntity.size()) {
+        return;
+    }
+    const std::size_t slot = m_slotOfEntity[entityIndex];
+    if (slot == NoSlot || bodies[slot] != body) {
+        return;
+    }
+    bodies[slot] = nullptr;
+    m_bodyEntities[slot] = NoEntity;
+    m_slotOfEntity[entityIndex] = NoSlot;
+}
+
+void TransformStorage::syncFromBodies(b2World& world) {
+    // Whatever moved last tick has its previous pose caught up. If it moves again it is
+    // found below, otherwise it has come to rest and needs one more draw at the final pose.
+    for (std::size_t slot : m_awakeSlots) {
+        if (slot >= m_owners.size()) {
+            continue;
+        }
+        if (m_moving[slot]) {
+            previousPositions[slot] = positions[slot];
+            previousRotations[slot] = rotations[slot];
+            m_moving[slot] = 0;
+            markRenderDirty(slot);
+        }
+    }
+    m_awakeSlots.clear();
+
+    for (b2Body* body = world.GetBodyList(); body; body = body->GetNext()) {
+        if (!body->IsAwake()) {
+            continue;
+        }
+        const std::uint32_t entityIndex = entityIndexOf(body);
+        if (entityIndex >= m_slotOfEntity.size()) {
+            continue;
+        }
+        const std::size_t slot = m_slotOfEntity[entityIndex];
+        if (slot != NoSlot && bodies[slot] == body) {
+            m_awakeSlots.push_back(slot);
+        }
+    }
+
+    // Each slot is written by exactly one chunk and bodies are only read, so a busy scene
+    // can be split across the job system. A handful of awake bodies isn't worth the hand-off.
+    JobSystem::getInstance().parallelFor(m_awakeSlots.size(), 1024, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::size_t slot = m_awakeSlots[i];
+            const b2Body* body = bodies[slot];
+            const b2Vec2& position = body->GetPosition();
+            const sf::Vector2f pixels(position.x * 30.0f, position.y * 30.0f); // convert to pixels
+            const float rotation = body->GetAngle() * 180.0f / b2_pi;
+            if (pixels == positions[slot] && rotation == rotations[slot]) {
+                continue;
+            }
+            positions[slot] = pixels;
+            rotations[slot] = rotation;
+            m_moving[slot] = 1;
+        }
+        });
+}
+
+void TransformStorage::publishDrawPoses(float alpha) {
+    auto publish = [this, alpha](std::size_t slot) {
+        drawPositions[slot] = interpolatedPosition(slot, alpha);
+        drawRotations[slot] = interpolatedRotation(slot, alpha);
+    };
+    for (std::size_t slot : m_renderDirtySlots) {
+        if (slot < m_owners.size() && m_renderDirty[slot]) {
+            publish(slot);
+        }
+    }
+    for (std::size_t slot : m_awakeSlots) {
+        if (slot < m_owners.size() && m_moving[slot]) {
+            publish(slot);
+        }
+    }
+}
+
+void TransformStorage::clearRenderDirty() {
+    for (std::size_t slot : m_renderDirtySlots) {
+        if (slot < m_renderDirty.size()) {
+            m_renderDirty[slot] = 0;
+        }
+    }
+    m_renderDirtySlots.clear();
+}
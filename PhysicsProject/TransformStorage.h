@@ -0,0 +1,85 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class TransformComponent;
+class b2Body;
+class b2World;
+
+// Hot transform data for every TransformComponent, kept in parallel arrays so the
+// physics sync and rendering can sweep them linearly. TransformComponent only holds
+// a slot index into these arrays. Slots are swap-removed, so they are not stable.
+class TransformStorage {
+public:
+    static TransformStorage& getInstance();
+
+    std::size_t allocate(TransformComponent* owner, const sf::Vector2f& position, const sf::Vector2f& scale, float rotation);
+    void release(std::size_t slot);
+    std::size_t size() const { return m_owners.size(); }
+
+    void attachBody(std::size_t slot, b2Body* body);
+    // Called before the body is destroyed, so nothing here keeps pointing at it
+    void detachBody(std::uint32_t entityIndex, const b2Body* body);
+
+    // Copies poses from the world's awake bodies only, keeping the pose from before the
+    // step in the previous arrays. Sleeping bodies are never visited, so the cost follows
+    // how much of the scene is moving. Called once per physics tick.
+    void syncFromBodies(b2World& world);
+
+    // Copies the interpolated pose of every render-dirty slot into the draw arrays. Called
+    // on the main thread while the simulation is not running, everything drawn after that
+    // reads the draw arrays, so a simulation thread can keep writing the live pose.
+    void publishDrawPoses(float alpha);
+
+    // Render prep only needs to rebuild a slot's shape or sprite when this is set: the
+    // slot was written directly, or it is still moving and being interpolated.
+    bool isRenderDirty(std::size_t slot) const { return m_renderDirty[slot] || m_moving[slot]; }
+    void markRenderDirty(std::size_t slot) {
+        if (!m_renderDirty[slot]) {
+            m_renderDirty[slot] = 1;
+            m_renderDirtySlots.push_back(slot);
+        }
+    }
+    // Called once render prep has consumed the flags
+    void clearRenderDirty();
+
+    // Pose blended between the last two physics ticks, alpha in [0, 1]
+    sf::Vector2f interpolatedPosition(std::size_t slot, float alpha) const {
+        return previousPositions[slot] + (positions[slot] - previousPositions[slot]) * alpha;
+    }
+    float interpolatedRotation(std::size_t slot, float alpha) const {
+        return previousRotations[slot] + (rotations[slot] - previousRotations[slot]) * alpha;
+    }
+
+    std::vector<sf::Vector2f> positions;
+    std::vector<sf::Vector2f> scales;
+    std::vector<float> rotations;
+    std::vector<b2Body*> bodies;
+    // Pose at the previous physics tick. Equal to the current pose for anything moved
+    // directly, so only simulated motion gets smoothed.
+    std::vector<sf::Vector2f> previousPositions;
+    std::vector<float> previousRotations;
+    // Snapshot of the interpolated pose taken by publishDrawPoses, what rendering reads
+    std::vector<sf::Vector2f> drawPositions;
+    std::vector<float> drawRotations;
+
+private:
+    TransformStorage() = default;
+    TransformStorage(const TransformStorage&) = delete;
+    TransformStorage& operator=(const TransformStorage&) = delete;
+
+    std::vector<TransformComponent*> m_owners;
+    // Set for slots whose body moved in the last tick, so previous != current
+    std::vector<std::uint8_t> m_moving;
+    std::vector<std::uint8_t> m_renderDirty;
+    std::vector<std::size_t> m_renderDirtySlots;
+    // Slots synced from an awake body in the last tick
+    std::vector<std::size_t> m_awakeSlots;
+    // Body's entity index to slot, so the body list can be mapped back to transforms
+    std::vector<std::size_t> m_slotOfEntity;
+    // The reverse, per slot. Kept here so releasing a slot never has to read the body,
+    // which may already be gone.
+    std::vector<std::uint32_t> m_bodyEntities;
+};
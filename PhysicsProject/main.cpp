@@ -1,12 +1,45 @@
 #include "Game.h"
+#include <cstring>
+#include <string>
 
-int main() {
-    Game game;
-    game.run();
-
-    // Clean up all GameObjects
-    for (auto& object : GameObject::getAllObjects()) {
-        delete object;
+// Usage: 2DPhysicsProject [--record file] [--replay file] [--speed factor] [--headless]
+//                         [--tick-rate hz] [--max-substeps n] [--threaded-physics]
+int main(int argc, char* argv[]) {
+    GameOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--record") == 0 && hasValue) {
+            options.recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--speed") == 0 && hasValue) {
+            options.replaySpeed = std::stof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && hasValue) {
+            options.physicsTickRate = std::stof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--max-substeps") == 0 && hasValue) {
+            options.maxPhysicsSubsteps = std::stoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--headless") == 0) {
+            options.headless = true;
+        }
+        else if (std::strcmp(argv[i], "--threaded-physics") == 0) {
+            options.threadedPhysics = true;
+        }
+        else {
+            std::cout << "Unknown argument: " << argv[i] << std::endl;
+        }
+    }
+    if (options.headless && options.replayPath.empty()) {
+        std::cout << "--headless needs --replay, opening a window" << std::endl;
+        options.headless = false;
     }
+
+    // The last scene is released by ~Game, while the physics world still exists
+    Game game(options);
+    game.run();
     return 0;
 }